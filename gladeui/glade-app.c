@@ -174,6 +174,8 @@ glade_app_dispose (GObject *app)
 	if (priv->clipboard)
 	{
 		gtk_widget_destroy (GTK_WIDGET (priv->clipboard->view));
+		priv->clipboard->view = NULL;
+		g_object_unref (priv->clipboard);
 		priv->clipboard = NULL;
 	}
 	/* FIXME: Remove projects */
@@ -913,12 +915,54 @@ glade_app_update_instance_count (GladeProject *project)
 	}
 }
 
+/* Sets up the toplevels of a newly added project, only the first
+ * window is shown, the others are realized when the user opens them.
+ */
+static void
+glade_app_setup_project_toplevels (GladeProject *project)
+{
+	GladeApp  *app = glade_app_get ();
+	GladeDesignView *view;
+	GladeDesignLayout *layout;
+
+	/* add acceleration groups to every top level widget */
+	if (app->priv->accel_group)
+		glade_project_set_accel_group (project, app->priv->accel_group);
+
+	/* Select the first window in the project */
+	if (g_list_length (app->priv->projects) == 1 ||
+	    !(view = glade_design_view_get_from_project (project)) ||
+	    !(layout = glade_design_view_get_layout (view)) ||
+	    !GTK_BIN (layout)->child)
+	{
+		const GList *node;
+		for (node = glade_project_get_objects (project);
+		     node != NULL;
+		     node = g_list_next (node))
+		{
+			GObject *obj = G_OBJECT (node->data);
+			if (GTK_IS_WINDOW (obj))
+				glade_widget_show (glade_widget_get_from_gobject (obj));
+			break;
+		}
+	}
+}
+
+static void
+on_project_parse_finished_cb (GladeProject *project,
+			      GladeApp     *app)
+{
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (on_project_parse_finished_cb),
+					      app);
+
+	glade_app_setup_project_toplevels (project);
+}
+
 void
 glade_app_add_project (GladeProject *project)
 {
 	GladeApp  *app;
-	GladeDesignView *view;
-	GladeDesignLayout *layout;
  	g_return_if_fail (GLADE_IS_PROJECT (project));
 
 	/* If the project was previously loaded, don't re-load */
@@ -941,29 +985,14 @@ glade_app_add_project (GladeProject *project)
 	g_signal_connect (G_OBJECT (project), "selection_changed",
 			  G_CALLBACK (on_project_selection_changed_cb), app);
 
-	/* add acceleration groups to every top level widget */
-	if (app->priv->accel_group)
-		glade_project_set_accel_group (project, app->priv->accel_group);
-	
 	glade_app_set_project (project);
 
-	/* Select the first window in the project */
-	if (g_list_length (app->priv->projects) == 1 ||
-	    !(view = glade_design_view_get_from_project (project)) ||
-	    !(layout = glade_design_view_get_layout (view)) ||
-	    !GTK_BIN (layout)->child)
-	{
-		const GList *node;
-		for (node = glade_project_get_objects (project);
-		     node != NULL;
-		     node = g_list_next (node))
-		{
-			GObject *obj = G_OBJECT (node->data);
-			if (GTK_IS_WINDOW (obj))
-				glade_widget_show (glade_widget_get_from_gobject (obj));
-			break;
-		}
-	}
+	/* A progressively loaded project has no toplevels yet */
+	if (glade_project_is_reading (project))
+		g_signal_connect (G_OBJECT (project), "parse-finished",
+				  G_CALLBACK (on_project_parse_finished_cb), app);
+	else
+		glade_app_setup_project_toplevels (project);
 
 	/* XXX I think the palette & editor should detect this by itself */
 	gtk_widget_set_sensitive (GTK_WIDGET (app->priv->palette), TRUE);
@@ -981,6 +1010,10 @@ glade_app_remove_project (GladeProject *project)
 
 	app->priv->projects = g_list_remove (app->priv->projects, project);
 
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (on_project_parse_finished_cb),
+					      app);
+
 	/* this is needed to prevent clearing the selection of a closed project 
 	 */
 	app->priv->active_project = NULL;
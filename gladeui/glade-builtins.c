@@ -349,17 +349,43 @@ glade_accel_glist_get_type (void)
 /****************************************************************
  *  Built-in GladeParamSpecAccel for accelerator properties     *
  ****************************************************************/
-gboolean
-glade_keyval_valid (guint val)
+static GHashTable *glade_keys_by_name  = NULL;
+static GHashTable *glade_keys_by_value = NULL;
+
+/* Index the GladeKeys table both ways on first use,
+ * the first name listed for a keyval wins.
+ */
+static void
+glade_keys_ensure_index (void)
 {
 	gint i;
 
+	if (glade_keys_by_name != NULL)
+		return;
+
+	glade_keys_by_name  = g_hash_table_new (g_str_hash, g_str_equal);
+	glade_keys_by_value = g_hash_table_new (NULL, NULL);
+
 	for (i = 0; GladeKeys[i].name != NULL; i++)
 	{
-		if (GladeKeys[i].value == val)
-			return TRUE;
+		gpointer value = GUINT_TO_POINTER (GladeKeys[i].value);
+
+		if (g_hash_table_lookup (glade_keys_by_name, GladeKeys[i].name) == NULL)
+			g_hash_table_insert (glade_keys_by_name, 
+					     (gpointer)GladeKeys[i].name, value);
+
+		if (g_hash_table_lookup (glade_keys_by_value, value) == NULL)
+			g_hash_table_insert (glade_keys_by_value, 
+					     value, (gpointer)GladeKeys[i].name);
 	}
-	return FALSE;
+}
+
+gboolean
+glade_keyval_valid (guint val)
+{
+	glade_keys_ensure_index ();
+
+	return g_hash_table_lookup (glade_keys_by_value, GUINT_TO_POINTER (val)) != NULL;
 }
 
 
@@ -695,26 +721,19 @@ glade_standard_boolean_spec (void)
 guint
 glade_builtin_key_from_string (const gchar *string)
 {
-	gint i;
-
 	g_return_val_if_fail (string != NULL, 0);
 
-	for (i = 0; GladeKeys[i].name != NULL; i++)
-		if (!strcmp (string, GladeKeys[i].name))
-			return GladeKeys[i].value;
+	glade_keys_ensure_index ();
 
-	return 0;
+	return GPOINTER_TO_UINT (g_hash_table_lookup (glade_keys_by_name, string));
 }
 
 const gchar *
 glade_builtin_string_from_key (guint key)
 {
-	gint i;
+	glade_keys_ensure_index ();
 
-	for (i = 0; GladeKeys[i].name != NULL; i++)
-		if (GladeKeys[i].value == key)
-			return GladeKeys[i].name;
-	return NULL;
+	return g_hash_table_lookup (glade_keys_by_value, GUINT_TO_POINTER (key));
 }
 
 GType
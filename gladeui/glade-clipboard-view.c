@@ -47,10 +47,26 @@
 const gint GLADE_CLIPBOARD_VIEW_WIDTH  = 230;
 const gint GLADE_CLIPBOARD_VIEW_HEIGHT = 200;
 
+static GObjectClass *parent_class = NULL;
+
+static void
+glade_clipboard_view_finalize (GObject *object)
+{
+	GladeClipboardView *view = GLADE_CLIPBOARD_VIEW (object);
+
+	g_hash_table_destroy (view->rows);
+
+	G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 glade_clipboard_view_class_init (GladeClipboardViewClass *klass)
 {
+	GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+	parent_class = g_type_class_peek_parent (klass);
 
+	object_class->finalize = glade_clipboard_view_finalize;
 }
 
 static void
@@ -59,6 +75,8 @@ glade_clipboard_view_init (GladeClipboardView *view)
 	view->widget = NULL;
 	view->clipboard = NULL;
 	view->model = NULL;
+	view->rows = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+					    (GDestroyNotify)gtk_tree_iter_free);
 }
 
 GType
@@ -113,22 +131,12 @@ static void
 glade_clipboard_view_populate_model (GladeClipboardView *view)
 {
 	GladeClipboard   *clipboard;
-	GtkTreeModel     *model;
-	GladeWidget      *widget;
 	GList            *list;
-	GtkTreeIter       iter;
 
 	clipboard = GLADE_CLIPBOARD (view->clipboard);
-	model     = GTK_TREE_MODEL (view->model);
 
 	for (list = clipboard->widgets; list; list = list->next) 
-	{
-		widget = list->data;
-		view->updating = TRUE;
-		gtk_list_store_append (GTK_LIST_STORE (model), &iter);
-		gtk_list_store_set (GTK_LIST_STORE (model), &iter, 0, widget, -1);
-		view->updating = FALSE;
-	}
+		glade_clipboard_view_add (view, list->data);
 }
 
 static void
@@ -315,6 +323,9 @@ glade_clipboard_view_add (GladeClipboardView *view, GladeWidget *widget)
 	gtk_list_store_append (view->model, &iter);
 	gtk_list_store_set    (view->model, &iter, 0, widget, -1);
 	view->updating = FALSE;
+
+	/* GtkListStore iters persist, keep one per widget */
+	g_hash_table_insert (view->rows, widget, gtk_tree_iter_copy (&iter));
 }
 
 /**
@@ -327,28 +338,19 @@ glade_clipboard_view_add (GladeClipboardView *view, GladeWidget *widget)
 void
 glade_clipboard_view_remove (GladeClipboardView *view, GladeWidget *widget)
 {
-	GtkTreeIter   iter;
-	GtkTreeModel *model;
-	GladeWidget  *clip_widget;
+	GtkTreeIter  *iter;
 
 	g_return_if_fail (GLADE_IS_CLIPBOARD_VIEW (view));
 	g_return_if_fail (GLADE_IS_WIDGET (widget));
 
-	model = GTK_TREE_MODEL (view->model);
-	if (gtk_tree_model_get_iter_first (model, &iter)) 
-	{
-		do 
-		{
-			gtk_tree_model_get (model, &iter, 0, &clip_widget, -1);
-			if (widget == clip_widget)
-				break;
-		}
-		while (gtk_tree_model_iter_next (model, &iter));
-	}
+	if ((iter = g_hash_table_lookup (view->rows, widget)) == NULL)
+		return;
 
 	view->updating = TRUE;
-	gtk_list_store_remove (view->model, &iter);
+	gtk_list_store_remove (view->model, iter);
 	view->updating = FALSE;
+
+	g_hash_table_remove (view->rows, widget);
 }
 
 /**
@@ -377,12 +379,8 @@ glade_clipboard_view_refresh_sel (GladeClipboardView *view)
 	     list && list->data; list = list->next)
 	{
 		widget = list->data;
-		if ((iter = glade_util_find_iter_by_widget 
-		     (GTK_TREE_MODEL (view->model), widget, 0)) != NULL)
-		{
+		if ((iter = g_hash_table_lookup (view->rows, widget)) != NULL)
 			gtk_tree_selection_select_iter (sel, iter);
-			/* gtk_tree_iter_free (iter); */
-		}
 	}
 	view->updating = FALSE;
 }
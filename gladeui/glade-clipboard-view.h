@@ -25,6 +25,7 @@ struct _GladeClipboardView
 	GladeClipboard *clipboard; /* The Clipboard for which this is a view */
 	gboolean        updating;  /* Prevent feedback from treeview when changing
 				    * the selecion. */
+	GHashTable     *rows;      /* GladeWidget -> GtkTreeIter in model */
 };
 
 struct _GladeClipboardViewClass
@@ -48,6 +48,8 @@ enum
 	PROP_HAS_SELECTION
 };
 
+static GObjectClass *parent_class = NULL;
+
 static void
 glade_project_get_property (GObject    *object,
 			    guint       prop_id,
@@ -67,14 +69,31 @@ glade_project_get_property (GObject    *object,
 	}
 }
 
+static void
+glade_clipboard_finalize (GObject *object)
+{
+	GladeClipboard *clipboard = GLADE_CLIPBOARD (object);
+
+	g_hash_table_destroy (clipboard->widget_links);
+	g_hash_table_destroy (clipboard->selection_links);
+
+	g_list_foreach (clipboard->widgets, (GFunc)g_object_unref, NULL);
+	g_list_free (clipboard->widgets);
+	g_list_free (clipboard->selection);
+
+	G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 glade_clipboard_class_init (GladeClipboardClass *klass)
 {
 	GObjectClass *object_class;
 
 	object_class = G_OBJECT_CLASS (klass);
+	parent_class = g_type_class_peek_parent (klass);
 
 	object_class->get_property = glade_project_get_property;
+	object_class->finalize     = glade_clipboard_finalize;
 
 	g_object_class_install_property (object_class,
 					 PROP_HAS_SELECTION,
@@ -92,6 +111,9 @@ glade_clipboard_init (GladeClipboard *clipboard)
 	clipboard->view      = NULL;
 	clipboard->selection = NULL;
 	clipboard->has_selection = FALSE;
+
+	clipboard->widget_links    = g_hash_table_new (g_direct_hash, g_direct_equal);
+	clipboard->selection_links = g_hash_table_new (g_direct_hash, g_direct_equal);
 }
 
 GType
@@ -165,6 +187,9 @@ glade_clipboard_new (void)
  * 
  * Adds @widgets to @clipboard.
  * This increases the reference count of each #GladeWidget in @widgets.
+ *
+ * The new widgets become the clipboard selection, the view selection
+ * is synchronized once after all widgets have been added.
  */
 void
 glade_clipboard_add (GladeClipboard *clipboard, GList *widgets)
@@ -172,6 +197,8 @@ glade_clipboard_add (GladeClipboard *clipboard, GList *widgets)
 	GladeWidget *widget;
 	GList       *list;
 
+	g_return_if_fail (GLADE_IS_CLIPBOARD (clipboard));
+
 	/*
 	 * Clear selection for the new widgets.
 	 */
@@ -182,23 +209,29 @@ glade_clipboard_add (GladeClipboard *clipboard, GList *widgets)
 	 */
 	for (list = widgets; list && list->data; list = list->next)
 	{
-		widget             = list->data;
+		widget = list->data;
+
+		if (g_hash_table_lookup (clipboard->widget_links, widget))
+			continue;
+
 		clipboard->widgets = 
 			g_list_prepend (clipboard->widgets, 
 					g_object_ref (G_OBJECT (widget)));
-		/*
-		 * Update view.
-		 */
+		g_hash_table_insert (clipboard->widget_links, 
+				     widget, clipboard->widgets);
+
 		glade_clipboard_selection_add (clipboard, widget);
 		if (clipboard->view)
-		{
 			glade_clipboard_view_add
 				(GLADE_CLIPBOARD_VIEW (clipboard->view), widget);
-			glade_clipboard_view_refresh_sel 
-				(GLADE_CLIPBOARD_VIEW (clipboard->view));
-		}
 	}
 
+	/*
+	 * Update view.
+	 */
+	if (clipboard->view)
+		glade_clipboard_view_refresh_sel 
+			(GLADE_CLIPBOARD_VIEW (clipboard->view));
 }
 
 /**
@@ -212,14 +245,20 @@ void
 glade_clipboard_remove (GladeClipboard *clipboard, GList *widgets)
 {
 	GladeWidget *widget;
-	GList       *list;
+	GList       *list, *link;
+
+	g_return_if_fail (GLADE_IS_CLIPBOARD (clipboard));
 
 	for (list = widgets; list && list->data; list = list->next)
 	{
-		widget               = list->data;
+		widget = list->data;
 
-		clipboard->widgets   = 
-			g_list_remove (clipboard->widgets, widget);
+		if ((link = g_hash_table_lookup (clipboard->widget_links, widget)) == NULL)
+			continue;
+
+		g_hash_table_remove (clipboard->widget_links, widget);
+		clipboard->widgets = 
+			g_list_delete_link (clipboard->widgets, link);
 		glade_clipboard_selection_remove (clipboard, widget);
 
 		/*
@@ -235,24 +274,46 @@ glade_clipboard_remove (GladeClipboard *clipboard, GList *widgets)
 	/* 
 	 * Only default selection if nescisary
 	 */
-	if ((g_list_length (clipboard->selection) < 1) &&
-	    (list = g_list_first (clipboard->widgets)) != NULL)
+	if (clipboard->selection == NULL && clipboard->widgets != NULL)
 	{
 		glade_clipboard_selection_add
-			(clipboard, GLADE_WIDGET (list->data));
-		glade_clipboard_view_refresh_sel 
-			(GLADE_CLIPBOARD_VIEW (clipboard->view));
+			(clipboard, GLADE_WIDGET (clipboard->widgets->data));
+		if (clipboard->view)
+			glade_clipboard_view_refresh_sel 
+				(GLADE_CLIPBOARD_VIEW (clipboard->view));
 	}
 }
 
+/**
+ * glade_clipboard_contains:
+ * @clipboard: a #GladeClipboard
+ * @widget: a #GladeWidget
+ *
+ * Returns: whether @widget is on @clipboard
+ */
+gboolean
+glade_clipboard_contains (GladeClipboard *clipboard,
+			  GladeWidget    *widget)
+{
+	g_return_val_if_fail (GLADE_IS_CLIPBOARD (clipboard), FALSE);
+
+	return g_hash_table_lookup (clipboard->widget_links, widget) != NULL;
+}
+
 void
 glade_clipboard_selection_add (GladeClipboard *clipboard, 
 			       GladeWidget    *widget)
 {
 	g_return_if_fail (GLADE_IS_CLIPBOARD (clipboard));
 	g_return_if_fail (GLADE_IS_WIDGET    (widget));
+
+	if (g_hash_table_lookup (clipboard->selection_links, widget))
+		return;
+
 	clipboard->selection =
 		g_list_prepend (clipboard->selection, widget);
+	g_hash_table_insert (clipboard->selection_links, 
+			     widget, clipboard->selection);
 
 	glade_clipboard_set_has_selection (clipboard, TRUE);
 }
@@ -261,12 +322,19 @@ void
 glade_clipboard_selection_remove (GladeClipboard *clipboard, 
 				  GladeWidget    *widget)
 {
+	GList *link;
+
 	g_return_if_fail (GLADE_IS_CLIPBOARD (clipboard));
 	g_return_if_fail (GLADE_IS_WIDGET    (widget));
+
+	if ((link = g_hash_table_lookup (clipboard->selection_links, widget)) == NULL)
+		return;
+
+	g_hash_table_remove (clipboard->selection_links, widget);
 	clipboard->selection = 
-		g_list_remove (clipboard->selection, widget);
+		g_list_delete_link (clipboard->selection, link);
 
-	if (g_list_length (clipboard->selection) == 0)
+	if (clipboard->selection == NULL)
 		glade_clipboard_set_has_selection (clipboard, FALSE);
 }
 
@@ -276,6 +344,7 @@ glade_clipboard_selection_clear (GladeClipboard *clipboard)
 	g_return_if_fail (GLADE_IS_CLIPBOARD (clipboard));
 	clipboard->selection = 
 		(g_list_free (clipboard->selection), NULL);
+	g_hash_table_remove_all (clipboard->selection_links);
 
 	glade_clipboard_set_has_selection (clipboard, FALSE);
 }
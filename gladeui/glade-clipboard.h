@@ -21,6 +21,9 @@ struct _GladeClipboard
 	GList     *selection;   /* Selection list of GladeWidget's */
 	gboolean   has_selection; /* TRUE if clipboard has selection */
 	GtkWidget *view;        /* see glade-clipboard-view.c */
+
+	GHashTable *widget_links;    /* GladeWidget -> link in widgets */
+	GHashTable *selection_links; /* GladeWidget -> link in selection */
 };
 
 struct _GladeClipboardClass
@@ -50,6 +53,9 @@ void            glade_clipboard_selection_clear  (GladeClipboard *clipboard);
 
 gboolean        glade_clipboard_get_has_selection  (GladeClipboard *clipboard);
 
+gboolean        glade_clipboard_contains         (GladeClipboard *clipboard,
+						  GladeWidget    *widget);
+
 
 G_END_DECLS
 
@@ -361,20 +361,19 @@ glade_command_set_property_execute (GladeCommand *cmd)
 		else
 			g_value_copy (sdata->new_value, &new_value);
 
-#if 0
+		GLADE_NOTE (COMMAND,
 		{
 			gchar *str =
 				glade_property_class_make_string_from_gvalue 
 				(sdata->property->klass, &new_value);
 
-			g_print ("Setting %s property of %s to %s (sumode: %d)\n",
-				 sdata->property->klass->id,
-				 sdata->property->widget->name,
-				 str, glade_property_superuser ());
+			g_message ("Setting %s property of %s to %s (sumode: %d)",
+				   sdata->property->klass->id,
+				   sdata->property->widget->name,
+				   str, glade_property_superuser ());
 
 			g_free (str);
-		}
-#endif
+		});
 
 		/* Packing properties need to be refreshed here since
 		 * they are reset when they get added to containers.
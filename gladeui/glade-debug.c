@@ -33,6 +33,17 @@
 #define RETSIGTYPE void
 #endif
 
+guint glade_debug_flags = 0;
+
+static const GDebugKey glade_debug_keys[] = {
+	{ "parser",  GLADE_DEBUG_PARSER },
+	{ "load",    GLADE_DEBUG_LOAD },
+	{ "save",    GLADE_DEBUG_SAVE },
+	{ "command", GLADE_DEBUG_COMMAND },
+	{ "plugin",  GLADE_DEBUG_PLUGIN },
+	{ "layout",  GLADE_DEBUG_LAYOUT }
+};
+
 
 static void
 glade_log_handler (const char *domain,
@@ -69,3 +80,28 @@ glade_setup_log_handlers ()
 	glade_set_log_handler ("Gdk");
 }
 
+/**
+ * glade_debug_set_flags:
+ * @flags: a list of trace categories separated by ':', ',' or spaces,
+ *         or "all"
+ *
+ * Enables the debug traces of the categories named in @flags,
+ * in addition to those already enabled; this has no effect unless
+ * Glade was built with debug traces.
+ *
+ * Returns: the enabled #GladeDebugFlags
+ */
+guint
+glade_debug_set_flags (const gchar *flags)
+{
+	g_return_val_if_fail (flags != NULL, glade_debug_flags);
+
+	glade_debug_flags |= g_parse_debug_string (flags, glade_debug_keys,
+						   G_N_ELEMENTS (glade_debug_keys));
+
+#ifndef GLADE_ENABLE_DEBUG
+	if (glade_debug_flags)
+		g_warning ("Debug traces were requested but are not compiled in");
+#endif
+	return glade_debug_flags;
+}
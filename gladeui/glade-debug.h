@@ -2,10 +2,55 @@
 #ifndef __GLADE_DEBUG_H__
 #define __GLADE_DEBUG_H__
 
+#include <glib.h>
+
 G_BEGIN_DECLS
 
+/**
+ * GladeDebugFlags:
+ * @GLADE_DEBUG_PARSER: trace the glade file parser
+ * @GLADE_DEBUG_LOAD: trace project loading
+ * @GLADE_DEBUG_SAVE: trace project saving
+ * @GLADE_DEBUG_COMMAND: trace commands, undo/redo and clipboard operations
+ * @GLADE_DEBUG_PLUGIN: trace plugin adaptors
+ * @GLADE_DEBUG_LAYOUT: record design layout hit tests, trace the selection
+ *                      node cache
+ *
+ * Categories of debug traces, see GLADE_NOTE().
+ */
+typedef enum {
+	GLADE_DEBUG_PARSER  = 1 << 0,
+	GLADE_DEBUG_LOAD    = 1 << 1,
+	GLADE_DEBUG_SAVE    = 1 << 2,
+	GLADE_DEBUG_COMMAND = 1 << 3,
+	GLADE_DEBUG_PLUGIN  = 1 << 4,
+	GLADE_DEBUG_LAYOUT  = 1 << 5
+} GladeDebugFlags;
+
+extern guint glade_debug_flags;
+
+/**
+ * GLADE_NOTE:
+ * @type: a #GladeDebugFlags category without the GLADE_DEBUG_ prefix
+ * @action: the statement to run when @type is enabled
+ *
+ * Runs @action only when tracing of @type was requested at runtime,
+ * traces are compiled out altogether unless GLADE_ENABLE_DEBUG is defined.
+ */
+#ifdef GLADE_ENABLE_DEBUG
+#define GLADE_NOTE(type,action)                                   \
+	G_STMT_START {                                            \
+		if (G_UNLIKELY (glade_debug_flags & GLADE_DEBUG_##type)) \
+			{ action; }                               \
+	} G_STMT_END
+#else
+#define GLADE_NOTE(type,action)
+#endif
+
 void glade_setup_log_handlers (void);
 
+guint glade_debug_set_flags   (const gchar *flags);
+
 G_END_DECLS
 
 #endif /* __GLADE_DEBUG_H__ */
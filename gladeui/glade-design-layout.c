@@ -27,6 +27,7 @@
 
 #include "glade.h"
 #include "glade-design-layout.h"
+#include "glade-debug.h"
 
 #include <gtk/gtk.h>
 
@@ -71,10 +72,18 @@ struct _GladeDesignLayoutPrivate
 	gint dy;                    /* child.height - event.pointer.y  */
 	gint new_width;             /* user's new requested width */
 	gint new_height;            /* user's new requested height */
+
+	/* hit testing index, the indexed widgets drop it when they
+	 * are destroyed or reparented */
+	GArray   *hit_nodes;        /* HitNode, in forall() pre-order */
+	GArray   *hit_slots;        /* sorted child indices of every node */
+	gboolean  hit_valid;
 };
 
 G_DEFINE_TYPE (GladeDesignLayout, glade_design_layout, GTK_TYPE_BIN)
 
+static void glade_design_layout_invalidate_hits (GladeDesignLayout *layout);
+
 static PointerRegion
 glade_design_layout_get_pointer_region (GladeDesignLayout *layout, gint x, gint y)
 {
@@ -206,6 +215,7 @@ glade_design_layout_update_child (GladeDesignLayout *layout,
 		      NULL);
 
 	gtk_widget_size_allocate (child, allocation);
+	glade_design_layout_invalidate_hits (layout);
 	gtk_widget_queue_resize (GTK_WIDGET (layout));
 }
 
@@ -314,6 +324,311 @@ glade_design_layout_deepest_widget_at_position (GtkContainer *toplevel,
 	return ret_widget;
 }
 
+/* Hit testing index.
+ *
+ * The widget hierarchy under the layout is flattened in pre-order (which
+ * is also gtk_container_forall() order) with every widget's area in
+ * layout coordinates, so pointer lookups do not have to translate
+ * coordinates through every level on each motion event. The children
+ * of each container are sorted along the axis they are laid out on,
+ * so the child under the pointer is found with a binary search.
+ *
+ * The index is rebuilt lazily after the layout gets reallocated. The
+ * contents of scrolling containers move without being reallocated, so
+ * lookups under them fall back to the recursive search above.
+ */
+typedef struct {
+	GtkWidget    *widget;
+	GdkRectangle  area;         /* in layout coordinates */
+	guint         first_slot;   /* first sorted child in priv->hit_slots */
+	guint         n_slots;
+	gint          max_extent;   /* largest child size along the sort axis */
+	guint         hittable   : 1;
+	guint         project    : 1;
+	guint         container  : 1;
+	guint         scrolls    : 1;
+	guint         axis_x     : 1;
+} HitNode;
+
+typedef struct {
+	GArray   *nodes;
+	gboolean  axis_x;
+} HitSortData;
+
+#define HIT_NODE(priv, i)   (&g_array_index ((priv)->hit_nodes, HitNode, (i)))
+#define HIT_SLOT(priv, i)   (g_array_index ((priv)->hit_slots, guint, (i)))
+#define HIT_START(node, x)  ((x) ? (node)->area.x : (node)->area.y)
+
+static gint
+hit_node_compare (gconstpointer a, gconstpointer b, HitSortData *data)
+{
+	HitNode *node_a = &g_array_index (data->nodes, HitNode, *(guint *)a);
+	HitNode *node_b = &g_array_index (data->nodes, HitNode, *(guint *)b);
+
+	return HIT_START (node_a, data->axis_x) - HIT_START (node_b, data->axis_x);
+}
+
+/* Drops the index, the indexed widgets are all alive here: any of them
+ * being destroyed drops the index first.
+ */
+static void
+glade_design_layout_invalidate_hits (GladeDesignLayout *layout)
+{
+	GladeDesignLayoutPrivate *priv = layout->priv;
+	guint i;
+
+	if (!priv->hit_valid)
+		return;
+
+	/* Node 0 is the layout itself */
+	for (i = 1; i < priv->hit_nodes->len; i++)
+		g_signal_handlers_disconnect_by_func (HIT_NODE (priv, i)->widget,
+						      G_CALLBACK (glade_design_layout_invalidate_hits),
+						      layout);
+
+	g_array_set_size (priv->hit_nodes, 0);
+	g_array_set_size (priv->hit_slots, 0);
+
+	priv->hit_valid = FALSE;
+}
+
+static guint
+glade_design_layout_build_hit_node (GladeDesignLayout *layout, GtkWidget *widget)
+{
+	GladeDesignLayoutPrivate *priv = layout->priv;
+	HitNode      node = { 0, };
+	HitNode     *child_node;
+	HitSortData  sort_data;
+	GArray      *children;
+	GList       *list, *l;
+	gint         x, y, max_width = 0, max_height = 0;
+	guint        index, child;
+
+	node.widget    = widget;
+	node.project   = glade_widget_get_from_gobject (widget) != NULL;
+	node.container = GTK_IS_CONTAINER (widget);
+	node.scrolls   = GTK_IS_VIEWPORT (widget) || GTK_IS_LAYOUT (widget);
+
+	if (gtk_widget_translate_coordinates (widget, GTK_WIDGET (layout), 0, 0, &x, &y))
+	{
+		node.hittable    = GTK_WIDGET_MAPPED (widget);
+		node.area.x      = x;
+		node.area.y      = y;
+		node.area.width  = widget->allocation.width;
+		node.area.height = widget->allocation.height;
+	}
+
+	index = priv->hit_nodes->len;
+	g_array_append_val (priv->hit_nodes, node);
+
+	/* Removed widgets may be kept for undo or finalized, either way
+	 * the index must not be used with them anymore.
+	 */
+	if (widget != GTK_WIDGET (layout))
+	{
+		g_signal_connect_swapped (widget, "destroy",
+					  G_CALLBACK (glade_design_layout_invalidate_hits),
+					  layout);
+		g_signal_connect_swapped (widget, "parent-set",
+					  G_CALLBACK (glade_design_layout_invalidate_hits),
+					  layout);
+	}
+
+	if (!node.container || node.scrolls)
+		return index;
+
+	children = g_array_new (FALSE, FALSE, sizeof (guint));
+
+	list = glade_util_container_get_all_children (GTK_CONTAINER (widget));
+	for (l = list; l; l = l->next)
+	{
+		child = glade_design_layout_build_hit_node (layout, l->data);
+		g_array_append_val (children, child);
+
+		child_node = HIT_NODE (priv, child);
+		max_width  = MAX (max_width,  child_node->area.width);
+		max_height = MAX (max_height, child_node->area.height);
+	}
+	g_list_free (list);
+
+	/* Sort along the axis the children are spread on: for a vbox the
+	 * children all share their width, but their heights are small. */
+	sort_data.nodes  = priv->hit_nodes;
+	sort_data.axis_x = max_width < max_height;
+	g_array_sort_with_data (children, (GCompareDataFunc)hit_node_compare, &sort_data);
+
+	child_node             = HIT_NODE (priv, index);
+	child_node->axis_x     = sort_data.axis_x;
+	child_node->max_extent = sort_data.axis_x ? max_width : max_height;
+	child_node->first_slot = priv->hit_slots->len;
+	child_node->n_slots    = children->len;
+
+	g_array_append_vals (priv->hit_slots, children->data, children->len);
+	g_array_free (children, TRUE);
+
+	return index;
+}
+
+/* Builds the index if needed, returns FALSE while the child is being
+ * resized by the user: every motion reallocates it then, so lookups
+ * use the recursive search and the index is only rebuilt once the
+ * resize is over.
+ */
+static gboolean
+glade_design_layout_ensure_hits (GladeDesignLayout *layout)
+{
+	GladeDesignLayoutPrivate *priv = layout->priv;
+
+	if (priv->hit_valid)
+		return TRUE;
+
+	if (priv->activity != ACTIVITY_NONE)
+		return FALSE;
+
+	g_array_set_size (priv->hit_nodes, 0);
+	g_array_set_size (priv->hit_slots, 0);
+
+	glade_design_layout_build_hit_node (layout, GTK_WIDGET (layout));
+
+	priv->hit_valid = TRUE;
+
+	return TRUE;
+}
+
+/* Returns the last child of @parent in forall() order that contains
+ * the point, ignoring widgets that are neither in the project nor
+ * containers unless @any is set; -1 if there is none.
+ */
+static gint
+glade_design_layout_hit_child (GladeDesignLayoutPrivate *priv,
+			       guint                     parent,
+			       gint                      x,
+			       gint                      y,
+			       gboolean                  any)
+{
+	HitNode *node = HIT_NODE (priv, parent), *child;
+	guint    lo, hi, mid, last;
+	gint     pos, found = -1;
+
+	pos  = node->axis_x ? x : y;
+	last = node->first_slot + node->n_slots;
+
+	/* Find the first child that may reach the pointer */
+	for (lo = node->first_slot, hi = last; lo < hi; )
+	{
+		mid   = (lo + hi) / 2;
+		child = HIT_NODE (priv, HIT_SLOT (priv, mid));
+		if (HIT_START (child, node->axis_x) + node->max_extent <= pos)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	for (; lo < last; lo++)
+	{
+		child = HIT_NODE (priv, HIT_SLOT (priv, lo));
+		if (HIT_START (child, node->axis_x) > pos)
+			break;
+
+		if (child->hittable &&
+		    x >= child->area.x && x < child->area.x + child->area.width &&
+		    y >= child->area.y && y < child->area.y + child->area.height &&
+		    (any || child->project || child->container) &&
+		    (gint)HIT_SLOT (priv, lo) > found)
+			found = HIT_SLOT (priv, lo);
+	}
+	return found;
+}
+
+/* Mirrors glade_design_layout_find_inside_container() */
+static gint
+glade_design_layout_hit_inside (GladeDesignLayoutPrivate *priv,
+				guint                     parent,
+				gint                      x,
+				gint                      y,
+				gboolean                  any)
+{
+	gint child;
+
+	if ((child = glade_design_layout_hit_child (priv, parent, x, y, any)) < 0)
+		return -1;
+
+	if (any || HIT_NODE (priv, child)->project)
+		return child;
+
+	/* Non project container (mostly for dialog buttons) */
+	if (HIT_NODE (priv, child)->scrolls)
+		return child;
+
+	return glade_design_layout_hit_inside (priv, child, x, y, any);
+}
+
+static GladeWidget *
+glade_design_layout_hit_gwidget (GladeDesignLayout *layout, gint x, gint y)
+{
+	GladeDesignLayoutPrivate *priv = layout->priv;
+	GladeWidget *gwidget;
+	HitNode     *node;
+	gint         parent = 0, owner = 0, child;
+
+	if (!glade_design_layout_ensure_hits (layout))
+		return glade_design_layout_deepest_gwidget_at_position
+			(GTK_CONTAINER (layout), GTK_CONTAINER (layout), x, y);
+
+	for (;;)
+	{
+		node = HIT_NODE (priv, parent);
+		if (node->scrolls)
+		{
+			gwidget = glade_design_layout_deepest_gwidget_at_position
+				(GTK_CONTAINER (layout), GTK_CONTAINER (node->widget), x, y);
+
+			/* A scrolling container outside the project with nothing
+			 * under the pointer yields the container searched from */
+			return gwidget ? gwidget :
+				glade_widget_get_from_gobject (HIT_NODE (priv, owner)->widget);
+		}
+
+		if ((child = glade_design_layout_hit_inside (priv, parent, x, y, FALSE)) < 0)
+			return glade_widget_get_from_gobject (node->widget);
+
+		if (!HIT_NODE (priv, child)->container)
+			return glade_widget_get_from_gobject (HIT_NODE (priv, child)->widget);
+
+		owner  = parent;
+		parent = child;
+	}
+}
+
+static GtkWidget *
+glade_design_layout_hit_widget (GladeDesignLayout *layout, gint x, gint y)
+{
+	GladeDesignLayoutPrivate *priv = layout->priv;
+	HitNode *node;
+	gint     parent = 0, child;
+
+	if (!glade_design_layout_ensure_hits (layout))
+		return glade_design_layout_deepest_widget_at_position
+			(GTK_CONTAINER (layout), GTK_CONTAINER (layout), x, y);
+
+	for (;;)
+	{
+		node = HIT_NODE (priv, parent);
+		if (node->scrolls)
+			return glade_design_layout_deepest_widget_at_position
+				(GTK_CONTAINER (layout), GTK_CONTAINER (node->widget), x, y);
+
+		if ((child = glade_design_layout_hit_inside (priv, parent, x, y, TRUE)) < 0)
+			return node->widget;
+
+		if (!HIT_NODE (priv, child)->container)
+			return HIT_NODE (priv, child)->widget;
+
+		parent = child;
+	}
+}
+
+
 static gboolean
 glade_design_layout_motion_notify_event (GtkWidget *widget, GdkEventMotion *ev)
 {
@@ -526,6 +841,8 @@ glade_design_layout_size_allocate (GtkWidget *widget, GtkAllocation *allocation)
 	widget->allocation = *allocation;
 	border_width = GTK_CONTAINER (widget)->border_width;
 
+	glade_design_layout_invalidate_hits (GLADE_DESIGN_LAYOUT (widget));
+
 	if (GTK_WIDGET_REALIZED (widget))
 	{
 		if (priv->event_window)
@@ -576,6 +893,8 @@ glade_design_layout_map (GtkWidget *widget)
 
 	GTK_WIDGET_CLASS (glade_design_layout_parent_class)->map (widget);
 
+	glade_design_layout_invalidate_hits (GLADE_DESIGN_LAYOUT (widget));
+
 }
 
 static void
@@ -587,6 +906,8 @@ glade_design_layout_unmap (GtkWidget *widget)
 
 	GTK_WIDGET_CLASS (glade_design_layout_parent_class)->unmap (widget);
 
+	glade_design_layout_invalidate_hits (GLADE_DESIGN_LAYOUT (widget));
+
 	if (priv->event_window)
 		gdk_window_hide (priv->event_window);
 }
@@ -630,6 +951,19 @@ glade_design_layout_realize (GtkWidget *widget)
 					     &attributes, attributes_mask);
 	gdk_window_set_user_data (priv->event_window, widget);
 
+	/* Cursors belong to a display, the layout is only given one here */
+	if (priv->cursor_resize_bottom == NULL)
+	{
+		GdkDisplay *display = gtk_widget_get_display (widget);
+
+		priv->cursor_resize_bottom       = 
+			gdk_cursor_new_for_display (display, GDK_BOTTOM_SIDE);
+		priv->cursor_resize_right        = 
+			gdk_cursor_new_for_display (display, GDK_RIGHT_SIDE);
+		priv->cursor_resize_bottom_right = 
+			gdk_cursor_new_for_display (display, GDK_BOTTOM_RIGHT_CORNER);
+	}
+
 	widget->style = gtk_style_attach (widget->style, widget->window);
 	gtk_style_set_background (widget->style, widget->window, GTK_STATE_NORMAL);
 }
@@ -668,7 +1002,10 @@ glade_design_layout_add (GtkContainer *container, GtkWidget *widget)
 
 	GTK_CONTAINER_CLASS (glade_design_layout_parent_class)->add (container, widget);
 
-	gdk_window_lower (layout->priv->event_window);
+	glade_design_layout_invalidate_hits (layout);
+
+	if (layout->priv->event_window)
+		gdk_window_lower (layout->priv->event_window);
 }
 
 static void
@@ -679,6 +1016,8 @@ glade_design_layout_remove (GtkContainer *container, GtkWidget *widget)
 					     container);	
 
 	GTK_CONTAINER_CLASS (glade_design_layout_parent_class)->remove (container, widget);
+
+	glade_design_layout_invalidate_hits (GLADE_DESIGN_LAYOUT (container));
 }
 
 static void
@@ -686,6 +1025,8 @@ glade_design_layout_dispose (GObject *object)
 {
 	GladeDesignLayoutPrivate *priv = GLADE_DESIGN_LAYOUT_GET_PRIVATE (object);
 
+	glade_design_layout_invalidate_hits (GLADE_DESIGN_LAYOUT (object));
+
 	if (priv->cursor_resize_bottom != NULL) {
 		gdk_cursor_unref (priv->cursor_resize_bottom);
 		priv->cursor_resize_bottom = NULL;
@@ -708,6 +1049,9 @@ glade_design_layout_finalize (GObject *object)
 	GladeDesignLayoutPrivate *priv = GLADE_DESIGN_LAYOUT_GET_PRIVATE (object);
 
 	g_slice_free (GtkRequisition, priv->current_size_request);
+
+	g_array_free (priv->hit_nodes, TRUE);
+	g_array_free (priv->hit_slots, TRUE);
 	
 	G_OBJECT_CLASS (glade_design_layout_parent_class)->finalize (object);
 }
@@ -792,6 +1136,29 @@ glade_design_layout_expose_event (GtkWidget *widget, GdkEventExpose *ev)
 	return TRUE;
 }
 
+/**
+ * glade_design_layout_widget_at:
+ * @layout: A #GladeDesignLayout
+ * @x: x coordinate in @layout
+ * @y: y coordinate in @layout
+ *
+ * Finds the deepest widget under a point, whether or not it is part
+ * of the project, the way events are dispatched by
+ * glade_design_layout_widget_event().
+ *
+ * Returns: the widget at @x, @y, or the container searched last if
+ *          it has no child there
+ */
+GtkWidget *
+glade_design_layout_widget_at (GladeDesignLayout *layout,
+			       gint               x,
+			       gint               y)
+{
+	g_return_val_if_fail (GLADE_IS_DESIGN_LAYOUT (layout), NULL);
+
+	return glade_design_layout_hit_widget (layout, x, y);
+}
+
 /**
  * glade_design_layout_widget_event:
  * @layout:        A #GladeDesignLayout
@@ -815,11 +1182,14 @@ glade_design_layout_widget_event (GladeDesignLayout *layout,
 	gint         x, y;
 	
 	gtk_widget_get_pointer (GTK_WIDGET (layout), &x, &y);
-	gwidget = glade_design_layout_deepest_gwidget_at_position
-		(GTK_CONTAINER (layout), GTK_CONTAINER (layout), x, y);
 
-	child = glade_design_layout_deepest_widget_at_position 
-		(GTK_CONTAINER (layout), GTK_CONTAINER (layout), x, y);
+	/* Recordings for tests/hit-test-benchmark */
+	GLADE_NOTE (LAYOUT, 
+		    if (event->type == GDK_MOTION_NOTIFY)
+			    g_message ("Hit test at %d,%d", x, y));
+
+	gwidget = glade_design_layout_hit_gwidget (layout, x, y);
+	child   = glade_design_layout_hit_widget (layout, x, y);
 
 	/* First try a placeholder */
 	if (GLADE_IS_PLACEHOLDER (child) && event->type != GDK_EXPOSE)
@@ -856,12 +1226,12 @@ glade_design_layout_init (GladeDesignLayout *layout)
 
 	priv->current_size_request = g_slice_new0 (GtkRequisition);
 
-	priv->cursor_resize_bottom       = gdk_cursor_new (GDK_BOTTOM_SIDE);
-	priv->cursor_resize_right        = gdk_cursor_new (GDK_RIGHT_SIDE);
-	priv->cursor_resize_bottom_right = gdk_cursor_new (GDK_BOTTOM_RIGHT_CORNER);
-
 	priv->new_width = -1;
 	priv->new_height = -1;
+
+	priv->hit_nodes = g_array_new (FALSE, FALSE, sizeof (HitNode));
+	priv->hit_slots = g_array_new (FALSE, FALSE, sizeof (guint));
+	priv->hit_valid = FALSE;
 }
 
 static void
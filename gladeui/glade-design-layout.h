@@ -62,6 +62,10 @@ gboolean     glade_design_layout_widget_event (GladeDesignLayout *layout,
                                                GladeWidget       *event_gwidget,
                                                GdkEvent          *event);
 
+GtkWidget   *glade_design_layout_widget_at    (GladeDesignLayout *layout,
+                                               gint               x,
+                                               gint               y);
+
 
 G_END_DECLS
 
@@ -2293,6 +2293,82 @@ glade_eprop_object_is_selected (GladeEditorProperty *eprop,
 }
 
 
+#define GLADE_EPROP_OBJECT_ANCESTORS "glade-eprop-object-ancestors"
+
+static GType
+glade_eprop_object_get_type_filter (GladeEditorProperty *eprop)
+{
+	if (GLADE_IS_PARAM_SPEC_OBJECTS (eprop->klass->pspec))
+		return glade_param_spec_objects_get_type 
+			(GLADE_PARAM_SPEC_OBJECTS(eprop->klass->pspec));
+	else
+		return eprop->klass->pspec->value_type;
+}
+
+static void
+glade_eprop_object_invalidate_ancestors (GladeProject *project,
+					 GladeWidget  *widget,
+					 GHashTable   *ancestors)
+{
+	g_hash_table_remove_all (ancestors);
+}
+
+/* Returns the set of project widgets that are of type @type or have
+ * a decendant of type @type (see glade_widget_has_decendant()), the
+ * set is built in a single pass over the project and cached per type
+ * until a widget is added to or removed from the project.
+ */
+static GHashTable *
+glade_eprop_object_get_ancestors (GladeProject *project,
+				  GType         type)
+{
+	GHashTable  *cache, *ancestors;
+	GladeWidget *gwidget;
+	GList       *list;
+	gboolean     is_interface = G_TYPE_IS_INTERFACE (type);
+
+	if ((cache = g_object_get_data (G_OBJECT (project), 
+					GLADE_EPROP_OBJECT_ANCESTORS)) == NULL)
+	{
+		cache = g_hash_table_new_full (NULL, NULL, NULL,
+					       (GDestroyNotify)g_hash_table_destroy);
+		g_object_set_data_full (G_OBJECT (project), 
+					GLADE_EPROP_OBJECT_ANCESTORS, cache,
+					(GDestroyNotify)g_hash_table_destroy);
+
+		g_signal_connect (G_OBJECT (project), "add-widget",
+				  G_CALLBACK (glade_eprop_object_invalidate_ancestors), cache);
+		g_signal_connect (G_OBJECT (project), "remove-widget",
+				  G_CALLBACK (glade_eprop_object_invalidate_ancestors), cache);
+	}
+
+	if ((ancestors = g_hash_table_lookup (cache, GSIZE_TO_POINTER (type))) != NULL)
+		return ancestors;
+
+	ancestors = g_hash_table_new (NULL, NULL);
+	g_hash_table_insert (cache, GSIZE_TO_POINTER (type), ancestors);
+
+	for (list = (GList *) glade_project_get_objects (project); list; list = list->next)
+	{
+		if ((gwidget = glade_widget_get_from_gobject (list->data)) == NULL)
+			continue;
+
+		if (is_interface ?
+		    !glade_util_class_implements_interface (gwidget->adaptor->type, type) :
+		    !g_type_is_a (gwidget->adaptor->type, type))
+			continue;
+
+		/* Mark the widget and its parents, stopping at the first
+		 * parent that was already marked by a previous match.
+		 */
+		for (; gwidget && g_hash_table_lookup (ancestors, gwidget) == NULL;
+		     gwidget = gwidget->parent)
+			g_hash_table_insert (ancestors, gwidget, gwidget);
+	}
+
+	return ancestors;
+}
+
 /*
  * Note that widgets is a list of GtkWidgets, while what we store
  * in the model are the associated GladeWidgets.
@@ -2301,11 +2377,13 @@ static void
 glade_eprop_object_populate_view_real (GladeEditorProperty *eprop,
 				       GtkTreeStore        *model,
 				       GList               *widgets,
-				       GtkTreeIter         *parent_iter)
+				       GtkTreeIter         *parent_iter,
+				       GHashTable          *ancestors)
 {
 	GList *children, *list;
 	GtkTreeIter       iter;
 	gboolean          good_type, has_decendant;
+	GType             type = glade_eprop_object_get_type_filter (eprop);
 
 	for (list = widgets; list; list = list->next)
 	{
@@ -2313,33 +2391,15 @@ glade_eprop_object_populate_view_real (GladeEditorProperty *eprop,
 
 		if ((widget = glade_widget_get_from_gobject (list->data)) != NULL)
 		{
+			has_decendant = g_hash_table_lookup (ancestors, widget) != NULL;
 
 			if (GLADE_IS_PARAM_SPEC_OBJECTS (eprop->klass->pspec))
-			{
-				has_decendant = glade_widget_has_decendant 
-					(widget, 
-					 glade_param_spec_objects_get_type 
-					 (GLADE_PARAM_SPEC_OBJECTS(eprop->klass->pspec)));
 				good_type = 
-					g_type_is_a
-					(widget->adaptor->type,
-					 glade_param_spec_objects_get_type 
-					 (GLADE_PARAM_SPEC_OBJECTS(eprop->klass->pspec))) ||
+					g_type_is_a (widget->adaptor->type, type) ||
 					glade_util_class_implements_interface
-					(widget->adaptor->type, 
-					 glade_param_spec_objects_get_type 
-					 (GLADE_PARAM_SPEC_OBJECTS(eprop->klass->pspec)));
-
-			}
+					(widget->adaptor->type, type);
 			else
-			{
-				has_decendant = glade_widget_has_decendant 
-					(widget, eprop->klass->pspec->value_type);
-
-				good_type = g_type_is_a (widget->adaptor->type, 
-							 eprop->klass->pspec->value_type);
-
-			}
+				good_type = g_type_is_a (widget->adaptor->type, type);
 			
 			if (good_type || has_decendant)
 			{
@@ -2368,7 +2428,8 @@ glade_eprop_object_populate_view_real (GladeEditorProperty *eprop,
 				GtkTreeIter *copy = NULL;
 
 				copy = gtk_tree_iter_copy (&iter);
-				glade_eprop_object_populate_view_real (eprop, model, children, copy);
+				glade_eprop_object_populate_view_real (eprop, model, children, 
+								       copy, ancestors);
 				gtk_tree_iter_free (copy);
 
 				g_list_free (children);
@@ -2383,8 +2444,13 @@ glade_eprop_object_populate_view (GladeEditorProperty *eprop,
 {
 	GtkTreeStore  *model = (GtkTreeStore *)gtk_tree_view_get_model (view);
 	GladeProject  *project = glade_app_get_project ();
+	GHashTable    *ancestors;
 	GList         *list, *toplevels = NULL;
 
+	/* Only subtrees holding a widget of the right type are walked */
+	ancestors = glade_eprop_object_get_ancestors
+		(project, glade_eprop_object_get_type_filter (eprop));
+
 	/* Make a list of only the toplevel widgets */
 	for (list = (GList *) glade_project_get_objects (project); list; list = list->next)
 	{
@@ -2393,11 +2459,12 @@ glade_eprop_object_populate_view (GladeEditorProperty *eprop,
 		g_assert (gwidget);
 
 		if (gwidget->parent == NULL)
-			toplevels = g_list_append (toplevels, object);
+			toplevels = g_list_prepend (toplevels, object);
 	}
+	toplevels = g_list_reverse (toplevels);
 
 	/* add the widgets and recurse */
-	glade_eprop_object_populate_view_real (eprop, model, toplevels, NULL);
+	glade_eprop_object_populate_view_real (eprop, model, toplevels, NULL, ancestors);
 	g_list_free (toplevels);
 }
 
@@ -3975,6 +4042,66 @@ glade_editor_property_supported (GParamSpec *pspec)
 }
 
 
+/* Whether one of @eprop's inputs has the keyboard focus, entries and
+ * spin buttons may then hold text that was not committed yet.
+ */
+static gboolean
+glade_editor_property_editing (GladeEditorProperty *eprop)
+{
+	GtkWidget *toplevel, *focus;
+
+	toplevel = gtk_widget_get_toplevel (GTK_WIDGET (eprop));
+	if (!GTK_WIDGET_TOPLEVEL (toplevel) || !GTK_IS_WINDOW (toplevel))
+		return FALSE;
+
+	focus = gtk_window_get_focus (GTK_WINDOW (toplevel));
+
+	return focus != NULL && 
+		(focus == GTK_WIDGET (eprop) ||
+		 gtk_widget_is_ancestor (focus, GTK_WIDGET (eprop)));
+}
+
+/* Whether the inputs of @eprop, currently loaded with another property,
+ * already display the value of @property. Only plain values are compared,
+ * the display of boxed, object and pointer values may depend on more than
+ * the value itself, and inputs being edited are always reloaded.
+ */
+static gboolean
+glade_editor_property_shows_value (GladeEditorProperty *eprop,
+				   GladeProperty       *property)
+{
+	if (eprop->property == NULL || property == NULL ||
+	    eprop->property == property ||
+	    eprop->property->klass != property->klass ||
+	    glade_editor_property_editing (eprop))
+		return FALSE;
+
+	switch (G_TYPE_FUNDAMENTAL (eprop->klass->pspec->value_type))
+	{
+	case G_TYPE_CHAR:
+	case G_TYPE_UCHAR:
+	case G_TYPE_BOOLEAN:
+	case G_TYPE_INT:
+	case G_TYPE_UINT:
+	case G_TYPE_LONG:
+	case G_TYPE_ULONG:
+	case G_TYPE_INT64:
+	case G_TYPE_UINT64:
+	case G_TYPE_ENUM:
+	case G_TYPE_FLAGS:
+	case G_TYPE_FLOAT:
+	case G_TYPE_DOUBLE:
+	case G_TYPE_STRING:
+		break;
+	default:
+		return FALSE;
+	}
+
+	return glade_property_class_compare (eprop->klass,
+					     eprop->property->value,
+					     property->value) == 0;
+}
+
 /**
  * glade_editor_property_load:
  * @eprop: A #GladeEditorProperty
@@ -3990,7 +4117,15 @@ glade_editor_property_load (GladeEditorProperty *eprop,
 	g_return_if_fail (property == NULL || GLADE_IS_PROPERTY (property));
 
 	eprop->loading = TRUE;
-	GLADE_EDITOR_PROPERTY_GET_CLASS (eprop)->load (eprop, property);
+
+	/* When switching between widgets of the same class the inputs often
+	 * already show the right value, only rebind them to the new property.
+	 */
+	if (glade_editor_property_shows_value (eprop, property))
+		editor_property_class->load (eprop, property);
+	else
+		GLADE_EDITOR_PROPERTY_GET_CLASS (eprop)->load (eprop, property);
+
 	eprop->loading = FALSE;
 }
 
@@ -312,6 +312,7 @@ glade_editor_init (GladeEditor *editor)
 {
 	GtkSizeGroup *size_group;
 	GtkWidget *hbox;
+	gint i;
 
 	editor->notebook     = gtk_notebook_new ();
 	editor->page_widget  = glade_editor_notebook_page (editor, _("_General"));
@@ -321,6 +322,11 @@ glade_editor_init (GladeEditor *editor)
 	editor->page_atk     = glade_editor_notebook_page (editor, _("Accessibility"));
 	editor->widget_tables = NULL;
 	editor->packing_etable = NULL;
+	editor->packing_tables =
+		g_hash_table_new_full (NULL, NULL, NULL,
+				       (GDestroyNotify)g_hash_table_destroy);
+	for (i = 0; i <= TABLE_TYPE_QUERY; i++)
+		editor->table_index[i] = g_hash_table_new (NULL, NULL);
 	editor->loading = FALSE;
 
 	gtk_container_set_border_width (GTK_CONTAINER (editor->notebook), 0);
@@ -645,23 +651,17 @@ glade_editor_get_table_from_class (GladeEditor *editor,
 				   GladeEditorTableType type)
 {
 	GladeEditorTable *table;
-	GList *list;
 
 	g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
 
-	for (list = editor->widget_tables; list; list = list->next)
-	{
-		table = list->data;
-		if (type != table->type)
-			continue;
-		if (table->adaptor == adaptor)
-			return table;
-	}
+	if ((table = g_hash_table_lookup (editor->table_index[type], adaptor)) != NULL)
+		return table;
 
 	table = glade_editor_table_create (editor, adaptor, type);
 	g_return_val_if_fail (table != NULL, NULL);
 
 	editor->widget_tables = g_list_prepend (editor->widget_tables, table);
+	g_hash_table_insert (editor->table_index[type], adaptor, table);
 
 	return table;
 }
@@ -782,69 +782,90 @@ glade_editor_load_widget_class (GladeEditor *editor, GladeWidgetAdaptor *adaptor
 	editor->loaded_adaptor = adaptor;
 }
 
-static gint
-glade_editor_property_comp (gconstpointer a, gconstpointer b)
-{
-	const GladeProperty *prop_a = a, *prop_b = b;
-	return glade_editor_property_class_comp (prop_a->klass, prop_b->klass);
-}
-
-static void
-glade_editor_load_packing_page (GladeEditor *editor, GladeWidget *widget)
+static GladeEditorTable *
+glade_editor_get_packing_table (GladeEditor        *editor,
+				GladeWidgetAdaptor *parent_adaptor,
+				GladeWidgetAdaptor *child_adaptor)
 {
+	GladeEditorTable    *table;
 	GladeEditorProperty *editor_property;
-	GladeProperty       *property;
-	GladeWidget         *parent;
+	GladePropertyClass  *property_class;
+	GHashTable          *child_tables;
 	GList               *list, *sorted_list;
-	GtkWidget           *child;
-
-	/* Remove the old properties */
-	if ((child = gtk_bin_get_child (GTK_BIN (editor->page_packing))) != NULL)
-		gtk_container_remove (GTK_CONTAINER (editor->page_packing), child);
 
-	/* Free the packing editor table */
-	if (editor->packing_etable)
-		editor->packing_etable =
-			(glade_editor_table_free (editor->packing_etable), NULL);
-
-	/* Free the packing editor properties (we gave ownership to 
-	 * packing_etable->table_widget, so no need to unref them here).
-	 */
-	editor->packing_eprops = (g_list_free (editor->packing_eprops), NULL);
-
-
-	/* if the widget is a toplevel there are no packing properties */
-	if (widget == NULL || (parent = glade_widget_get_parent (widget)) == NULL)
-		return;
+	if ((child_tables = g_hash_table_lookup (editor->packing_tables, parent_adaptor)) == NULL)
+	{
+		child_tables = g_hash_table_new (NULL, NULL);
+		g_hash_table_insert (editor->packing_tables, parent_adaptor, child_tables);
+	}
+	else if ((table = g_hash_table_lookup (child_tables, child_adaptor)) != NULL)
+		return table;
 
-	/* Now add the new properties */
-	editor->packing_etable         = glade_editor_table_new ();
-	editor->packing_etable->editor = editor;
-	editor->packing_etable->type   = TABLE_TYPE_PACKING;
+	table          = glade_editor_table_new ();
+	table->editor  = editor;
+	table->adaptor = child_adaptor;
+	table->type    = TABLE_TYPE_PACKING;
 
 	/* Sort packing properties by weight */
-	sorted_list = g_list_copy (widget->packing_properties);
-	sorted_list = g_list_sort (sorted_list, glade_editor_property_comp);
+	sorted_list = g_list_copy (parent_adaptor->packing_props);
+	sorted_list = g_list_sort (sorted_list, glade_editor_property_class_comp);
 	
 	for (list = sorted_list; list && list->data; list = list->next)
 	{
-		property               = GLADE_PROPERTY (list->data);
+		property_class = list->data;
 		
-		if (glade_property_class_is_visible (property->klass) == FALSE)
+		if (glade_property_class_is_visible (property_class) == FALSE)
 			continue;
 		
-		editor_property        = glade_editor_table_append_item (editor->packing_etable, 
-									 property->klass, FALSE);
-		editor->packing_eprops = g_list_prepend (editor->packing_eprops, editor_property);
-		glade_editor_property_load (editor_property, property);
+		editor_property   = glade_editor_table_append_item (table, property_class, FALSE);
+		table->properties = g_list_prepend (table->properties, editor_property);
 	}
 
 	g_list_free (sorted_list);
 	
-	gtk_widget_show (editor->packing_etable->table_widget);
+	gtk_widget_show (table->table_widget);
+
+	editor->widget_tables = g_list_prepend (editor->widget_tables, table);
+	g_hash_table_insert (child_tables, child_adaptor, table);
+
+	return table;
+}
+
+static void
+glade_editor_load_packing_page (GladeEditor *editor, GladeWidget *widget)
+{
+	GladeEditorTable    *table = NULL;
+	GladeEditorProperty *editor_property;
+	GladeWidget         *parent;
+	GList               *list;
+
+	/* if the widget is a toplevel there are no packing properties */
+	if (widget != NULL && (parent = glade_widget_get_parent (widget)) != NULL)
+		table = glade_editor_get_packing_table (editor, parent->adaptor, widget->adaptor);
+
+	/* Swap the page only when the container/child pair changed */
+	if (table != editor->packing_etable)
+	{
+		if (editor->packing_etable)
+			gtk_container_remove (GTK_CONTAINER (editor->page_packing), 
+					      editor->packing_etable->table_widget);
+		if (table)
+			gtk_container_add (GTK_CONTAINER (editor->page_packing), 
+					   table->table_widget);
+
+		editor->packing_etable = table;
+	}
 
-	gtk_container_add (GTK_CONTAINER (editor->page_packing), 
-			   editor->packing_etable->table_widget);
+	if (table == NULL)
+		return;
+
+	for (list = table->properties; list; list = list->next)
+	{
+		editor_property = list->data;
+		glade_editor_property_load
+			(editor_property, 
+			 glade_widget_get_pack_property (widget, editor_property->klass->id));
+	}
 }
 
 static void
@@ -1517,14 +1538,6 @@ glade_editor_show_context_info (GladeEditor *editor)
 					(GLADE_EDITOR_PROPERTY (props->data));
 		}	
 
-		if (editor->packing_etable)
-		{
-			etable = editor->packing_etable;
-			for (props = etable->properties; props; props = props->next)
-				glade_editor_property_show_info
-					(GLADE_EDITOR_PROPERTY (props->data));
-		
-		}
 		g_object_notify (G_OBJECT (editor), "show-context-info");
 	}
 }
@@ -1549,14 +1562,6 @@ glade_editor_hide_context_info (GladeEditor *editor)
 					(GLADE_EDITOR_PROPERTY (props->data));
 		}	
 
-		if (editor->packing_etable)
-		{
-			etable = editor->packing_etable;
-			for (props = etable->properties; props; props = props->next)
-				glade_editor_property_hide_info
-					(GLADE_EDITOR_PROPERTY (props->data));
-		
-		}
 		g_object_notify (G_OBJECT (editor), "show-context-info");
 	}
 }
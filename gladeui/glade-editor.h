@@ -84,13 +84,20 @@ struct _GladeEditor
 				* we are asked to load a widget of a particular
 				* GladeWidgetClass
 				*/
+
+	GHashTable *table_index[TABLE_TYPE_QUERY + 1]; /* One index per GladeEditorTableType
+							* mapping a GladeWidgetAdaptor to its
+							* table in widget_tables
+							*/
+
+	GHashTable *packing_tables; /* Packing pages are created once per container
+				     * adaptor and child adaptor pair; maps the parent
+				     * GladeWidgetAdaptor to a table mapping the child
+				     * GladeWidgetAdaptor to its GladeEditorTable.
+				     */
 				
-	GladeEditorTable *packing_etable; /* Packing pages are dynamicly created each
-					   * selection, this pointer is only to free
-					   * the last packing page.
-					   */
-	 
-	GList            *packing_eprops; /* Current list of packing GladeEditorProperties
+	GladeEditorTable *packing_etable; /* The packing page currently shown, owned
+					   * by packing_tables.
 					   */
 
 	gboolean loading; /* Use when loading a GladeWidget into the editor
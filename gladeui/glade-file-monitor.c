@@ -0,0 +1,296 @@
+/* -*- Mode: C; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "config.h"
+#include "glade-file-monitor.h"
+#include "glade-debug.h"
+
+#include <glib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* Milliseconds without events before the changed files are reported,
+ * editors usually write a file in several steps (or through a rename).
+ */
+#define GLADE_FILE_MONITOR_DELAY 150
+
+struct _GladeFileMonitor
+{
+	gint                  wd;         /* The inotify watch on the directory */
+	GladeFileMonitorFunc  func;
+	gpointer              user_data;
+
+	GList                *pending;    /* Basenames changed since the last report */
+	guint                 timeout_id; /* Reports them after a quiet period */
+};
+
+#ifdef HAVE_SYS_INOTIFY_H
+
+static gint        inotify_fd       = -1;
+static GHashTable *inotify_monitors = NULL; /* watch descriptor -> GList of monitors,
+					     * the kernel gives the same descriptor
+					     * to every watch on a directory.
+					     */
+
+static gboolean
+glade_file_monitor_report (GladeFileMonitor *monitor)
+{
+	GList *pending = monitor->pending, *l;
+
+	monitor->pending    = NULL;
+	monitor->timeout_id = 0;
+
+	pending = g_list_reverse (pending);
+	monitor->func (pending, monitor->user_data);
+
+	/* @monitor may be gone by now */
+	for (l = pending; l; l = l->next)
+		g_free (l->data);
+	g_list_free (pending);
+
+	return FALSE;
+}
+
+static void
+glade_file_monitor_queue (GladeFileMonitor *monitor,
+			  const gchar      *filename)
+{
+	GList *l;
+
+	for (l = monitor->pending; l; l = l->next)
+		if (!strcmp ((gchar *)l->data, filename))
+			break;
+	if (l == NULL)
+		monitor->pending = g_list_prepend (monitor->pending, g_strdup (filename));
+
+	/* Wait for the file to settle */
+	if (monitor->timeout_id)
+		g_source_remove (monitor->timeout_id);
+	monitor->timeout_id =
+		g_timeout_add (GLADE_FILE_MONITOR_DELAY,
+			       (GSourceFunc)glade_file_monitor_report, monitor);
+}
+
+static gboolean
+glade_file_monitor_read (GIOChannel   *source,
+			 GIOCondition  condition,
+			 gpointer      data)
+{
+	union {
+		struct inotify_event event;
+		gchar                buffer[4096];
+	} events;
+	struct inotify_event *event;
+	GList                *l;
+	gssize                len, i;
+
+	while ((len = read (inotify_fd, events.buffer, sizeof (events.buffer))) > 0)
+	{
+		for (i = 0; i < len; i += sizeof (struct inotify_event) + event->len)
+		{
+			event = (struct inotify_event *)&events.buffer[i];
+
+			if (event->len == 0)
+				continue;
+
+			GLADE_NOTE (LOAD, g_message ("File %s changed (0x%x)",
+						     event->name, event->mask));
+
+			for (l = g_hash_table_lookup (inotify_monitors,
+						      GINT_TO_POINTER (event->wd));
+			     l; l = l->next)
+				glade_file_monitor_queue (l->data, event->name);
+		}
+	}
+	return TRUE;
+}
+
+static gboolean
+glade_file_monitor_init (void)
+{
+	GIOChannel *channel;
+
+	if (inotify_monitors)
+		return inotify_fd >= 0;
+
+	inotify_monitors = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+	if ((inotify_fd = inotify_init ()) < 0)
+	{
+		g_warning ("Could not monitor files for external changes: %s",
+			   g_strerror (errno));
+		return FALSE;
+	}
+	fcntl (inotify_fd, F_SETFL, fcntl (inotify_fd, F_GETFL) | O_NONBLOCK);
+	fcntl (inotify_fd, F_SETFD, FD_CLOEXEC);
+
+	channel = g_io_channel_unix_new (inotify_fd);
+	g_io_add_watch (channel, G_IO_IN, glade_file_monitor_read, NULL);
+	g_io_channel_unref (channel);
+
+	return TRUE;
+}
+
+#endif /* HAVE_SYS_INOTIFY_H */
+
+/**
+ * glade_file_monitor_new:
+ * @dirname: the directory to monitor
+ * @func: the function to call with the files that changed in @dirname
+ * @user_data: data to pass to @func
+ *
+ * Monitors the files in @dirname, watching the directory rather than
+ * single files catches editors which save through a rename.
+ *
+ * Returns: a new #GladeFileMonitor, or %NULL if files cannot be monitored
+ *          on this platform; callers should fall back to comparing
+ *          modification times.
+ */
+GladeFileMonitor *
+glade_file_monitor_new (const gchar          *dirname,
+			GladeFileMonitorFunc  func,
+			gpointer              user_data)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+	GladeFileMonitor *monitor;
+	GList            *monitors;
+	gint              wd;
+
+	g_return_val_if_fail (dirname != NULL, NULL);
+	g_return_val_if_fail (func != NULL, NULL);
+
+	if (!glade_file_monitor_init ())
+		return NULL;
+
+	if ((wd = inotify_add_watch (inotify_fd, dirname,
+				     IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM |
+				     IN_CREATE | IN_DELETE)) < 0)
+		return NULL;
+
+	monitor = g_new0 (GladeFileMonitor, 1);
+	monitor->wd        = wd;
+	monitor->func      = func;
+	monitor->user_data = user_data;
+
+	monitors = g_hash_table_lookup (inotify_monitors, GINT_TO_POINTER (wd));
+	g_hash_table_insert (inotify_monitors, GINT_TO_POINTER (wd),
+			     g_list_prepend (monitors, monitor));
+
+	return monitor;
+#else
+	return NULL;
+#endif
+}
+
+/**
+ * glade_file_monitor_destroy:
+ * @monitor: a #GladeFileMonitor
+ *
+ * Stops monitoring and frees @monitor, pending changes are not reported.
+ */
+void
+glade_file_monitor_destroy (GladeFileMonitor *monitor)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+	GList *l;
+
+	g_return_if_fail (monitor != NULL);
+
+	l = g_hash_table_lookup (inotify_monitors, GINT_TO_POINTER (monitor->wd));
+	l = g_list_remove (l, monitor);
+
+	if (l)
+		g_hash_table_insert (inotify_monitors, GINT_TO_POINTER (monitor->wd), l);
+	else
+	{
+		g_hash_table_remove (inotify_monitors, GINT_TO_POINTER (monitor->wd));
+		inotify_rm_watch (inotify_fd, monitor->wd);
+	}
+
+	if (monitor->timeout_id)
+		g_source_remove (monitor->timeout_id);
+
+	for (l = monitor->pending; l; l = l->next)
+		g_free (l->data);
+	g_list_free (monitor->pending);
+
+	g_free (monitor);
+#endif
+}
+
+/**
+ * glade_file_digest:
+ * @filename: A filename
+ * @digest: the #GladeFileDigest to fill
+ *
+ * Summarizes the contents of @filename, so that a change notification
+ * can be told apart from an actual change of contents (modification
+ * times only have a granularity of a second).
+ */
+void
+glade_file_digest (const gchar     *filename,
+		   GladeFileDigest *digest)
+{
+	gchar   *contents;
+	gsize    length, i;
+	guint32  hash = 2166136261U;
+
+	g_return_if_fail (filename != NULL);
+	g_return_if_fail (digest != NULL);
+
+	memset (digest, 0, sizeof (GladeFileDigest));
+
+	if (!g_file_get_contents (filename, &contents, &length, NULL))
+		return;
+
+	/* FNV-1a */
+	for (i = 0; i < length; i++)
+	{
+		hash ^= (guchar)contents[i];
+		hash *= 16777619U;
+	}
+	g_free (contents);
+
+	digest->exists = TRUE;
+	digest->length = length;
+	digest->hash   = hash;
+}
+
+/**
+ * glade_file_digest_equal:
+ * @a: a #GladeFileDigest
+ * @b: a #GladeFileDigest
+ *
+ * Returns: whether @a and @b were taken from the same contents
+ */
+gboolean
+glade_file_digest_equal (const GladeFileDigest *a,
+			 const GladeFileDigest *b)
+{
+	g_return_val_if_fail (a != NULL && b != NULL, FALSE);
+
+	return a->exists == b->exists &&
+		a->length == b->length &&
+		a->hash   == b->hash;
+}
@@ -0,0 +1,61 @@
+/* -*- Mode: C; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __GLADE_FILE_MONITOR_H__
+#define __GLADE_FILE_MONITOR_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GladeFileMonitor GladeFileMonitor;
+typedef struct _GladeFileDigest  GladeFileDigest;
+
+/**
+ * GladeFileMonitorFunc:
+ * @filenames: the basenames of the files that changed
+ * @user_data: the data passed to glade_file_monitor_new()
+ *
+ * Called once the files in a monitored directory have stopped
+ * changing for a little while, @filenames lists each file once.
+ */
+typedef void (*GladeFileMonitorFunc) (const GList *filenames,
+				      gpointer     user_data);
+
+struct _GladeFileDigest
+{
+	gboolean exists;
+	gsize    length;
+	guint32  hash;
+};
+
+GladeFileMonitor    *glade_file_monitor_new       (const gchar          *dirname,
+						   GladeFileMonitorFunc  func,
+						   gpointer              user_data);
+
+void                 glade_file_monitor_destroy   (GladeFileMonitor     *monitor);
+
+void                 glade_file_digest            (const gchar          *filename,
+						   GladeFileDigest      *digest);
+
+gboolean             glade_file_digest_equal      (const GladeFileDigest *a,
+						   const GladeFileDigest *b);
+
+G_END_DECLS
+
+#endif /* __GLADE_FILE_MONITOR_H__ */
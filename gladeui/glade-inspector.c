@@ -77,6 +77,10 @@ struct _GladeInspectorPrivate
 	GtkTreeStore *model;
 
 	GladeProject *project;
+
+	GList        *pending; /* toplevels added by a progressive load, waiting
+				* for the end of the chunk to be added to the model
+				*/
 };
 
 
@@ -340,9 +344,8 @@ update_model (GladeInspector *inspector)
 }
 
 static void
-project_add_widget_cb (GladeProject   *project,
-		       GladeWidget    *widget,
-		       GladeInspector *inspector)
+add_widget (GladeInspector *inspector,
+	    GladeWidget    *widget)
 {
 	GladeWidget *parent_widget;
 	GtkTreeIter widget_iter, *parent_iter = NULL;
@@ -367,6 +370,54 @@ project_add_widget_cb (GladeProject   *project,
 	g_list_free (l);
 }
 
+static void
+flush_pending (GladeInspector *inspector)
+{
+	GList *l;
+
+	for (l = inspector->priv->pending; l; l = l->next)
+		add_widget (inspector, GLADE_WIDGET (l->data));
+
+	g_list_free (inspector->priv->pending);
+	inspector->priv->pending = NULL;
+}
+
+static void
+project_add_widget_cb (GladeProject   *project,
+		       GladeWidget    *widget,
+		       GladeInspector *inspector)
+{
+	/* While a chunk is read, only queue the toplevels, their children
+	 * are added to the model along with them at the end of the chunk;
+	 * widgets added by the user between chunks are added right away.
+	 */
+	if (glade_project_is_loading (project))
+	{
+		if (glade_widget_get_parent (widget) == NULL)
+			inspector->priv->pending = 
+				g_list_append (inspector->priv->pending, widget);
+		return;
+	}
+
+	add_widget (inspector, widget);
+}
+
+static void
+project_load_progress_cb (GladeProject   *project,
+			  guint           loaded,
+			  guint           total,
+			  GladeInspector *inspector)
+{
+	flush_pending (inspector);
+}
+
+static void
+project_parse_finished_cb (GladeProject   *project,
+			   GladeInspector *inspector)
+{
+	flush_pending (inspector);
+}
+
 static void
 project_remove_widget_cb (GladeProject   *project,
 			  GladeWidget    *widget,
@@ -374,6 +425,8 @@ project_remove_widget_cb (GladeProject   *project,
 {
 	GtkTreeIter *iter;
 
+	inspector->priv->pending = g_list_remove (inspector->priv->pending, widget);
+
 	iter = glade_util_find_iter_by_widget (GTK_TREE_MODEL (inspector->priv->model),
 					       widget,
 					       WIDGET_COLUMN);
@@ -678,6 +731,15 @@ disconnect_project_signals (GladeInspector *inspector,
 	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
 					      G_CALLBACK (project_selection_changed_cb),
 					      inspector);
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_load_progress_cb),
+					      inspector);
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_parse_finished_cb),
+					      inspector);
+
+	g_list_free (inspector->priv->pending);
+	inspector->priv->pending = NULL;
 }
 
 static void
@@ -696,6 +758,12 @@ connect_project_signals (GladeInspector *inspector,
 	g_signal_connect (G_OBJECT (project), "selection-changed",
 			  G_CALLBACK (project_selection_changed_cb),
 			  inspector);
+	g_signal_connect (G_OBJECT (project), "load-progress",
+			  G_CALLBACK (project_load_progress_cb),
+			  inspector);
+	g_signal_connect (G_OBJECT (project), "parse-finished",
+			  G_CALLBACK (project_parse_finished_cb),
+			  inspector);
 }
 
 /**
@@ -67,11 +67,13 @@ enum {
 	LAST_SIGNAL
 };
 
+typedef struct _IconIndex IconIndex;
+
 struct _GladeNamedIconChooserDialogPrivate
 {
 	GtkWidget          *icons_view; 
 	GtkTreeModel       *filter_model;       /* filtering model  */
-	GtkListStore       *icons_store;        /* data store       */
+	GtkListStore       *icons_store;        /* data store, shared by all dialogs for a theme */
 	GtkTreeSelection   *selection;
 
 	GtkWidget          *contexts_view;
@@ -89,7 +91,7 @@ struct _GladeNamedIconChooserDialogPrivate
 	                                          * and the widget is mapped */
 	
 	GtkIconTheme       *icon_theme;          /* the current icon theme */
-	guint               load_id;             /* id of the idle function for loading data into model */
+	IconIndex          *icon_index;          /* the icon index we are waiting on, if still loading */
 	
 	gboolean            settings_list_standard;   /* whether to list standard icon names only */
 	
@@ -907,20 +909,6 @@ is_standard_icon_name (const gchar *icon_name)
 
 }
 
-static void
-cleanup_after_load (GladeNamedIconChooserDialog *dialog)
-{
-	GDK_THREADS_ENTER ();
-
-	dialog->priv->load_id = 0;
-	
-	pending_select_name_process (dialog);
-
-	set_busy_cursor (dialog, FALSE);
-	
-	GDK_THREADS_LEAVE ();
-}
-
 static void
 chooser_set_model (GladeNamedIconChooserDialog *dialog)
 {
@@ -946,73 +934,255 @@ chooser_set_model (GladeNamedIconChooserDialog *dialog)
 
 typedef struct
 {
-	gchar *name;
-	gint  context;
+	gchar    *name;
+	gint      context;
+	gboolean  standard;
 } IconData;
 
+/* A process-wide index of the named icons in a theme, listed once (a
+ * context per main loop iteration, GtkIconTheme is not thread safe) and
+ * sorted on a worker thread, then loaded in chunks into a store that is
+ * shared by every dialog using that theme.
+ */
+struct _IconIndex
+{
+	GtkIconTheme *icon_theme;
+	gulong        changed_id;  /* 0 once the index is stale */
+
+	guint         n_listed;  /* number of standard_contexts already listed */
+	GPtrArray    *icons;     /* IconData, sorted before the store is loaded */
+	guint         n_loaded;  /* number of icons already in the store */
+	GtkListStore *store;
+
+	gboolean      complete;
+	gboolean      stale;     /* the theme changed while we were loading */
+	GList        *waiters;   /* dialogs waiting for the store to be complete */
+};
+
+#define ICON_INDEX_CHUNK 256
+
+static GHashTable *icon_indexes = NULL;
+
 static gint
-icon_data_compare (IconData *a, IconData *b)
+icon_data_compare (IconData **a, IconData **b)
 {
-	return g_ascii_strcasecmp (a->name, b->name);
+	return g_ascii_strcasecmp ((*a)->name, (*b)->name);
 }
 
-static gboolean
-reload_icons (GladeNamedIconChooserDialog *dialog)
+static void
+icon_data_free (IconData *data)
 {
-	GtkListStore *store = dialog->priv->icons_store;
-	GtkTreeIter   iter;
-	guint         i;
-	GList        *l, *icons = NULL;
+	g_free (data->name);
+	g_slice_free (IconData, data);
+}
 
-	GDK_THREADS_ENTER ();
+static void
+icon_index_free (IconIndex *index)
+{
+	if (index->changed_id)
+		g_signal_handler_disconnect (index->icon_theme, index->changed_id);
 
-	/* retrieve icon names from each context */
-	for (i = 0; i < G_N_ELEMENTS (standard_contexts); i++) {
+	if (index->icons)
+	{
+		g_ptr_array_foreach (index->icons, (GFunc) icon_data_free, NULL);
+		g_ptr_array_free (index->icons, TRUE);
+	}
 
-		GList *icons_in_context = gtk_icon_theme_list_icons (dialog->priv->icon_theme,
-								     standard_contexts[i].name);
+	g_object_unref (index->store);
+	g_slice_free (IconIndex, index);
+}
 
-		for (l = icons_in_context; l; l = l->next) {
+static void
+icon_index_theme_changed (GtkIconTheme *icon_theme,
+			  IconIndex    *index)
+{
+	/* Dialogs reload through style-set and will get a fresh index,
+	 * those still holding this store keep their own reference.
+	 */
+	if (g_hash_table_lookup (icon_indexes, icon_theme) == index)
+		g_hash_table_remove (icon_indexes, icon_theme);
 
-			IconData *data = g_slice_new (IconData);
+	if (index->complete)
+		icon_index_free (index);
+	else
+	{
+		/* Later changes are for the index that replaces this one */
+		g_signal_handler_disconnect (icon_theme, index->changed_id);
+		index->changed_id = 0;
+		index->stale      = TRUE;
+	}
+}
 
-			data->name = (gchar *) l->data;
-			data->context = i;
+static void
+icon_index_serve (IconIndex                   *index,
+		  GladeNamedIconChooserDialog *dialog)
+{
+	dialog->priv->icon_index  = NULL;
+	dialog->priv->icons_store = g_object_ref (index->store);
 
-			icons = g_list_prepend (icons, data);
-		}
-		
-		g_list_free (icons_in_context);
-	} 
-	
-	/* sort icon names */
-	icons = g_list_sort (icons, (GCompareFunc) icon_data_compare);
+	chooser_set_model (dialog);
 
-	/* put into to model */
-	for (l = icons; l; l = l->next) {
-	
-		IconData *data = (IconData *) l->data;
-		
-		gtk_list_store_append (store, &iter);
-		gtk_list_store_set (store, &iter,
+	pending_select_name_process (dialog);
+
+	set_busy_cursor (dialog, FALSE);
+}
+
+static gboolean
+icon_index_load (IconIndex *index)
+{
+	GtkTreeIter  iter;
+	GList       *waiters, *l;
+	guint        i;
+
+	GDK_THREADS_ENTER ();
+
+	for (i = 0; i < ICON_INDEX_CHUNK && index->n_loaded < index->icons->len; i++)
+	{
+		IconData *data = g_ptr_array_index (index->icons, index->n_loaded++);
+
+		gtk_list_store_append (index->store, &iter);
+		gtk_list_store_set (index->store, &iter,
 				    ICONS_CONTEXT_COLUMN,  data->context,
-				    ICONS_STANDARD_COLUMN, is_standard_icon_name (data->name), 
+				    ICONS_STANDARD_COLUMN, data->standard, 
 				    ICONS_NAME_COLUMN,     data->name,
-			    	    -1);
-		
-		g_free (data->name);
-		g_slice_free (IconData, data);
-	}	
-	
-	g_list_free (icons);
-	
-	chooser_set_model (dialog);	
-	
-	GDK_THREADS_LEAVE ();	
-	
+				    -1);
+	}
+
+	if (index->n_loaded < index->icons->len)
+	{
+		GDK_THREADS_LEAVE ();
+		return TRUE;
+	}
+
+	/* The names are copied into the store, the array is no longer needed */
+	g_ptr_array_foreach (index->icons, (GFunc) icon_data_free, NULL);
+	g_ptr_array_free (index->icons, TRUE);
+	index->icons    = NULL;
+	index->complete = TRUE;
+
+	waiters        = index->waiters;
+	index->waiters = NULL;
+
+	for (l = waiters; l; l = l->next)
+		icon_index_serve (index, l->data);
+	g_list_free (waiters);
+
+	if (index->stale)
+		icon_index_free (index);
+
+	GDK_THREADS_LEAVE ();
+
 	return FALSE;
 }
 
+static void
+icon_index_sort (IconIndex *index)
+{
+	guint i;
+
+	g_ptr_array_sort (index->icons, (GCompareFunc) icon_data_compare);
+
+	for (i = 0; i < index->icons->len; i++)
+	{
+		IconData *data = g_ptr_array_index (index->icons, i);
+		data->standard = is_standard_icon_name (data->name);
+	}
+}
+
+/* Runs on a worker thread, only touches the index's own data */
+static gpointer
+icon_index_sort_thread (IconIndex *index)
+{
+	icon_index_sort (index);
+
+	g_idle_add_full (G_PRIORITY_HIGH_IDLE + 300,
+			 (GSourceFunc) icon_index_load, index, NULL);
+	return NULL;
+}
+
+/* Lists the icons of one context per call, then sorts them */
+static gboolean
+icon_index_list (IconIndex *index)
+{
+	GList *icons_in_context, *l;
+
+	GDK_THREADS_ENTER ();
+
+	icons_in_context = 
+		gtk_icon_theme_list_icons (index->icon_theme, 
+					   standard_contexts[index->n_listed].name);
+
+	for (l = icons_in_context; l; l = l->next)
+	{
+		IconData *data = g_slice_new0 (IconData);
+
+		data->name    = (gchar *) l->data;
+		data->context = index->n_listed;
+
+		g_ptr_array_add (index->icons, data);
+	}
+	g_list_free (icons_in_context);
+
+	if (++index->n_listed < G_N_ELEMENTS (standard_contexts))
+	{
+		GDK_THREADS_LEAVE ();
+		return TRUE;
+	}
+
+	if (!g_thread_supported () ||
+	    !g_thread_create ((GThreadFunc) icon_index_sort_thread, index, FALSE, NULL))
+	{
+		icon_index_sort (index);
+		g_idle_add_full (G_PRIORITY_HIGH_IDLE + 300,
+				 (GSourceFunc) icon_index_load, index, NULL);
+	}
+
+	GDK_THREADS_LEAVE ();
+
+	return FALSE;
+}
+
+static void
+icon_index_request (GtkIconTheme                *icon_theme,
+		    GladeNamedIconChooserDialog *dialog)
+{
+	IconIndex *index;
+
+	if (icon_indexes == NULL)
+		icon_indexes = g_hash_table_new (NULL, NULL);
+
+	if ((index = g_hash_table_lookup (icon_indexes, icon_theme)) == NULL)
+	{
+		index = g_slice_new0 (IconIndex);
+		index->icon_theme = icon_theme;
+		index->icons      = g_ptr_array_new ();
+		index->store      = gtk_list_store_new (ICONS_N_COLUMNS,
+							G_TYPE_UINT,
+							G_TYPE_BOOLEAN, 
+							G_TYPE_STRING);
+		index->changed_id =
+			g_signal_connect (icon_theme, "changed",
+					  G_CALLBACK (icon_index_theme_changed), index);
+
+		g_hash_table_insert (icon_indexes, icon_theme, index);
+
+		/* GtkIconTheme is not thread safe, icon names are retrieved
+		 * from the main loop, a context at a time so that the dialog
+		 * shows up (busy) before the theme is read.
+		 */
+		g_idle_add_full (G_PRIORITY_HIGH_IDLE + 300,
+				 (GSourceFunc) icon_index_list, index, NULL);
+	}
+
+	if (index->complete)
+		icon_index_serve (index, dialog);
+	else
+	{
+		index->waiters = g_list_prepend (index->waiters, dialog);
+		dialog->priv->icon_index = index;
+	}
+}
+
 static void
 change_icon_theme (GladeNamedIconChooserDialog *dialog)
 {
@@ -1020,15 +1190,25 @@ change_icon_theme (GladeNamedIconChooserDialog *dialog)
 		dialog->priv->icon_theme = get_icon_theme_for_widget (GTK_WIDGET (dialog));
 
 	gtk_tree_view_set_model (GTK_TREE_VIEW (dialog->priv->icons_view), NULL);
-	gtk_list_store_clear (dialog->priv->icons_store);
 
-	set_busy_cursor (dialog, TRUE);
+	if (dialog->priv->icon_index)
+	{
+		dialog->priv->icon_index->waiters =
+			g_list_remove (dialog->priv->icon_index->waiters, dialog);
+		dialog->priv->icon_index = NULL;
+	}
 
-	dialog->priv->load_id = g_idle_add_full (G_PRIORITY_HIGH_IDLE + 300,
-						 (GSourceFunc) reload_icons,
-						 dialog,
-						 (GDestroyNotify) cleanup_after_load);
+	if (dialog->priv->icons_store)
+	{
+		g_object_unref (dialog->priv->icons_store);
+		dialog->priv->icons_store = NULL;
+	}
+
+	dialog->priv->filter_model = NULL;
+
+	set_busy_cursor (dialog, TRUE);
 
+	icon_index_request (dialog->priv->icon_theme, dialog);
 }
 
 static void
@@ -1198,6 +1378,13 @@ glade_named_icon_chooser_dialog_finalize (GObject *object)
 		g_free (dialog->priv->pending_select_name);
 		dialog->priv->pending_select_name = NULL;
 	}
+
+	if (dialog->priv->icon_index)
+		dialog->priv->icon_index->waiters =
+			g_list_remove (dialog->priv->icon_index->waiters, dialog);
+
+	if (dialog->priv->icons_store)
+		g_object_unref (dialog->priv->icons_store);
 	
 	G_OBJECT_CLASS (glade_named_icon_chooser_dialog_parent_class)->finalize (object);
 }
@@ -1354,6 +1541,7 @@ glade_named_icon_chooser_dialog_init (GladeNamedIconChooserDialog *dialog)
 	
 	dialog->priv->filter_model = NULL;
 	dialog->priv->icons_store = NULL;
+	dialog->priv->icon_index = NULL;
 	dialog->priv->context_id = -1;
 	dialog->priv->pending_select_name = NULL;
 	dialog->priv->last_focus_widget = NULL;
@@ -1492,14 +1680,6 @@ glade_named_icon_chooser_dialog_init (GladeNamedIconChooserDialog *dialog)
 	gtk_box_pack_start (GTK_BOX (GTK_DIALOG (dialog)->vbox), contents, TRUE, TRUE, 0);
 					
 	gtk_widget_pop_composite_child ();
-	
-	/* underlying model */
-  	dialog->priv->icons_store = gtk_list_store_new (ICONS_N_COLUMNS,
-  		                                        G_TYPE_UINT,
-  		                                        G_TYPE_BOOLEAN, 
-  		                                        G_TYPE_STRING);
-  	                                        
-                                       
 }
 
 static void
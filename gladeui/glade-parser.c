@@ -33,8 +33,7 @@
 
 #include "glade-parser.h"
 #include "glade.h"
-
-#define GLADE_NOTE(a,b)
+#include "glade-debug.h"
 
 typedef enum {
     PARSER_START,
@@ -1119,13 +1118,16 @@ dump_widget_panda(xmlNode *parent_node, GladeWidgetInfo *info, GladeChildInfo *c
     }
 }
 
+/* Builds the document for @interface, or only its <project> header
+ * for the project named @project_name when @interface is %NULL.
+ */
 static xmlDoc *
-glade_interface_make_doc_panda (GladeInterface *interface)
+glade_interface_make_doc_panda (GladeInterface *interface, const gchar *project_name)
 {
     xmlDoc *doc;
     xmlNode *root, *node1, *node2;
     gint i;
-    gchar *name;
+    const gchar *name;
 
     doc = xmlNewDoc(BAD_CAST("1.0"));
     doc->standalone = FALSE;
@@ -1133,7 +1135,9 @@ glade_interface_make_doc_panda (GladeInterface *interface)
     root = xmlNewNode(NULL, BAD_CAST("GTK-Interface"));
     xmlDocSetRootElement(doc, root);
 
-    if (interface->n_toplevels > 0) {
+    if (interface == NULL) {
+      name = project_name ? project_name : "empty";
+    } else if (interface->n_toplevels > 0) {
       name = interface->toplevels[0]->name;
     } else {
       name = "empty";
@@ -1166,7 +1170,7 @@ glade_interface_make_doc_panda (GladeInterface *interface)
 	xmlNodeAddContent(node2, BAD_CAST("False"));
 	xmlAddChild(node1, node2);
 
-    for (i = 0; i < interface->n_toplevels; i++) {
+    for (i = 0; interface && i < interface->n_toplevels; i++) {
 	    dump_widget_panda(root, interface->toplevels[i], NULL, NULL);
     }
     return doc;
@@ -1222,7 +1226,7 @@ glade_interface_buffer_panda (GladeInterface  *interface,
     g_return_if_fail (ret       != NULL);
     g_return_if_fail (size      != NULL);
 
-    doc = glade_interface_make_doc_panda (interface);
+    doc = glade_interface_make_doc_panda (interface, NULL);
     xmlDocDumpFormatMemoryEnc(doc, (xmlChar **)&buf1,size,"UTF-8",TRUE);
 
     reg = g_regex_new("<(.*)/>",G_REGEX_RAW,0,NULL); 
@@ -1246,6 +1250,142 @@ glade_interface_buffer_panda (GladeInterface  *interface,
     xmlFreeDoc(doc);
 }
 
+/* Dumps @doc and returns what lies between the root element's
+ * start and end tags, with empty elements expanded.
+ */
+static gchar *
+glade_interface_buffer_panda_body (xmlDoc *doc, gchar **header, gchar **footer)
+{
+    gchar *buf, *start, *end, *tmp, *body = NULL;
+    gint size;
+    GRegex *reg;
+
+    xmlDocDumpFormatMemoryEnc(doc, (xmlChar **)&buf,&size,"UTF-8",TRUE);
+    if (buf == NULL)
+      return NULL;
+
+    if ((start = strstr(buf, "<GTK-Interface>\n")) != NULL &&
+        (end = g_strrstr(buf, "</GTK-Interface>")) != NULL) {
+      start += strlen("<GTK-Interface>\n");
+
+      tmp = g_strndup(start, end - start);
+      reg = g_regex_new("<(.*)/>",G_REGEX_RAW,0,NULL); 
+      body = g_regex_replace_eval(reg,tmp,-1,0,0,eval_cb1,NULL,NULL);
+      g_regex_unref(reg);
+      g_free(tmp);
+
+      if (header)
+        *header = g_strndup(buf, start - buf);
+      if (footer)
+        *footer = g_strdup(end);
+    }
+    xmlFree(buf);
+    return body;
+}
+
+/**
+ * glade_parser_dump_uses_fragments:
+ *
+ * Returns: whether glade_parser_dump_fragments() can be used
+ *          to write the current output format.
+ */
+gboolean
+glade_parser_dump_uses_fragments (void)
+{
+    const gchar *env = g_getenv("OUTPUT_GLADE_3_FORMAT");
+
+    return env == NULL || strlen(env) == 0;
+}
+
+/**
+ * glade_parser_widget_fragment:
+ * @info: the #GladeWidgetInfo of a toplevel widget
+ *
+ * Serializes a toplevel widget for glade_parser_dump_fragments().
+ *
+ * Returns: a newly allocated string
+ */
+gchar *
+glade_parser_widget_fragment (GladeWidgetInfo *info)
+{
+    xmlDoc *doc;
+    xmlNode *root;
+    gchar *fragment;
+
+    g_return_val_if_fail (info != NULL, NULL);
+
+    doc = xmlNewDoc(BAD_CAST("1.0"));
+    root = xmlNewNode(NULL, BAD_CAST("GTK-Interface"));
+    xmlDocSetRootElement(doc, root);
+    dump_widget_panda(root, info, NULL, NULL);
+
+    fragment = glade_interface_buffer_panda_body (doc, NULL, NULL);
+    xmlFreeDoc(doc);
+
+    return fragment ? fragment : g_strdup ("");
+}
+
+/**
+ * glade_parser_dump_fragments:
+ * @project_name: the name written in the project header
+ * @fragments: a #GList of toplevel fragments made by 
+ *             glade_parser_widget_fragment()
+ * @filename: the filename to write the interface data to.
+ * @error: a #GError for error handleing.
+ *
+ * Writes a glade file made of already serialized toplevels, this
+ * gives the same output as glade_parser_interface_dump() without
+ * serializing the unchanged toplevels again.
+ *
+ * Returns whether the write was successfull or not.
+ */
+gboolean
+glade_parser_dump_fragments (const gchar  *project_name,
+			     GList        *fragments,
+			     const gchar  *filename,
+			     GError      **error)
+{
+    xmlDoc *doc;
+    GString *buffer;
+    GRegex *reg;
+    gchar *header = NULL, *footer = NULL, *body, *tmp;
+    GList *l;
+    gboolean ret;
+
+    g_return_val_if_fail (filename != NULL, FALSE);
+
+    doc = glade_interface_make_doc_panda (NULL, project_name);
+    body = glade_interface_buffer_panda_body (doc, &header, &footer);
+    xmlFreeDoc(doc);
+
+    if (body == NULL)
+    {
+	g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_NOMEM,
+		     _("Could not allocate memory for interface"));
+	return FALSE;
+    }
+
+    reg = g_regex_new("(<\\?xml.*)encoding=\"EUC-JP\"(.*>)",G_REGEX_RAW,0,NULL); 
+    tmp = g_regex_replace_eval(reg,header,-1,0,0,eval_cb2,NULL,NULL);
+    g_regex_unref(reg);
+
+    buffer = g_string_new (tmp);
+    g_string_append (buffer, body);
+    for (l = fragments; l; l = l->next)
+      g_string_append (buffer, l->data);
+    g_string_append (buffer, footer);
+
+    ret = g_file_set_contents(filename, buffer->str, buffer->len, error);
+
+    g_string_free (buffer, TRUE);
+    g_free (tmp);
+    g_free (header);
+    g_free (footer);
+    g_free (body);
+
+    return ret;
+}
+
 /***********************************
  * end of panda
  ***********************************/
@@ -152,6 +152,15 @@ gboolean        glade_parser_interface_dump (GladeInterface  *interface,
 					     const gchar     *filename,
 					     GError         **error);
 
+gboolean        glade_parser_dump_uses_fragments (void);
+
+gchar          *glade_parser_widget_fragment (GladeWidgetInfo *info);
+
+gboolean        glade_parser_dump_fragments (const gchar     *project_name,
+					     GList           *fragments,
+					     const gchar     *filename,
+					     GError         **error);
+
 G_CONST_RETURN gchar *glade_parser_pvalue_from_winfo (GladeWidgetInfo *winfo,
 						      const gchar     *pname);
 
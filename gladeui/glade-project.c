@@ -43,6 +43,8 @@
 #include "glade-app.h"
 #include "glade-marshallers.h"
 #include "glade-catalog.h"
+#include "glade-debug.h"
+#include "glade-file-monitor.h"
 
 #include "glade-project.h"
 
@@ -59,6 +61,9 @@ enum
 	RESOURCE_REMOVED,
 	CHANGED,
 	PARSE_FINISHED,
+	LOAD_PROGRESS,
+	FILE_CHANGED,
+	RESOURCE_CHANGED,
 	LAST_SIGNAL
 };
 
@@ -115,14 +120,47 @@ struct _GladeProjectPrivate
 	GtkAccelGroup *accel_group;
 
 	GHashTable *resources; /* resource filenames & thier associated properties */
+	GHashTable *resource_refs; /* resource filename -> number of properties using it */
+
+	GHashTable *adaptor_refs; /* GladeWidgetAdaptor -> number of its objects in the project */
+	GHashTable *catalog_refs; /* catalog name -> number of its objects in the project */
+
+	GladeInterface *load_interface; /* The interface being read by glade_project_load_progressive() */
+	guint           load_next;      /* The next toplevel of load_interface to read */
+	guint           load_id;        /* The idle source reading the next chunk */
+
+	GHashTable *fragments; /* toplevel GladeWidget -> its serialized form as of the
+				* last save, toplevels changed since then are not listed
+				*/
 	
 	gchar *comment;        /* XML comment, Glade will preserve whatever comment was
 			        * in file, so users can delete or change it.
 			        */
 			 
 	time_t  mtime;         /* last UTC modification time of file, or 0 if it could not be read */
+
+	GladeFileMonitor *monitor;     /* Watches the directory of the file and its resources,
+					* NULL if that is not supported (then mtime is used).
+					*/
+	GladeFileDigest   file_digest; /* The contents of the file as of the last load or save */
+	GladeFileDigest   file_seen;   /* The contents of the file as of the last change notification */
+	gboolean          reload_declined; /* The user declined to reload file_declined */
+	GladeFileDigest   file_declined;   /* The contents the user declined to reload */
+	time_t            mtime_declined;  /* Same, without a monitor; 0 if none was declined */
+
+	GList      *pending_references; /* GladePendingReference list of object properties
+					 * to resolve once loading is complete
+					 */
+	GHashTable *name_index;         /* widget name -> GladeWidget, only valid while
+					 * resolving the pending references
+					 */
 };
 
+typedef struct {
+	GladeProperty *property;
+	gchar         *value;
+} GladePendingReference;
+
 
 static guint              glade_project_signals[LAST_SIGNAL] = {0};
 
@@ -132,6 +170,8 @@ static gboolean glade_project_load_from_interface (GladeProject   *project,
 						   GladeInterface *interface,
 						   const gchar    *path);
 
+#define GLADE_PROJECT_LOAD_SLICE 0.05 /* seconds of reading per idle iteration */
+
 
 G_DEFINE_TYPE (GladeProject, glade_project, G_TYPE_OBJECT)
 
@@ -160,6 +200,23 @@ glade_project_list_unref (GList *original_list)
 		g_list_free (original_list);
 }
 
+static void
+glade_project_free_references (GladeProject *project)
+{
+	GladePendingReference *reference;
+	GList                 *l;
+
+	for (l = project->priv->pending_references; l; l = l->next)
+	{
+		reference = l->data;
+		g_object_unref (reference->property);
+		g_free (reference->value);
+		g_free (reference);
+	}
+	g_list_free (project->priv->pending_references);
+	project->priv->pending_references = NULL;
+}
+
 static void
 glade_project_dispose (GObject *object)
 {
@@ -167,6 +224,14 @@ glade_project_dispose (GObject *object)
 	GList        *list;
 	GladeWidget  *gwidget;
 	
+	glade_project_cancel_load (project);
+
+	if (project->priv->monitor)
+	{
+		glade_file_monitor_destroy (project->priv->monitor);
+		project->priv->monitor = NULL;
+	}
+
 	/* Emit close signal */
 	g_signal_emit (object, glade_project_signals [CLOSE], 0);
 	
@@ -175,6 +240,8 @@ glade_project_dispose (GObject *object)
 	glade_project_list_unref (project->priv->undo_stack);
 	project->priv->undo_stack = NULL;
 
+	glade_project_free_references (project);
+
 	/* Unparent all widgets in the heirarchy first 
 	 * (Since we are bookkeeping exact reference counts, we 
 	 * dont want the hierarchy to just get destroyed)
@@ -218,6 +285,10 @@ glade_project_finalize (GObject *object)
 	g_hash_table_destroy (project->priv->widget_names_allocator);
 	g_hash_table_destroy (project->priv->widget_old_names);
 	g_hash_table_destroy (project->priv->resources);
+	g_hash_table_destroy (project->priv->resource_refs);
+	g_hash_table_destroy (project->priv->adaptor_refs);
+	g_hash_table_destroy (project->priv->catalog_refs);
+	g_hash_table_destroy (project->priv->fragments);
 
 	G_OBJECT_CLASS (glade_project_parent_class)->finalize (object);
 }
@@ -490,6 +561,16 @@ glade_project_init (GladeProject *project)
 	priv->resources = g_hash_table_new_full (g_direct_hash, 
 						 g_direct_equal, 
 						 NULL, g_free);
+	priv->resource_refs = g_hash_table_new_full (g_str_hash, 
+						     g_str_equal, 
+						     g_free, NULL);
+	priv->adaptor_refs = g_hash_table_new (g_direct_hash, g_direct_equal);
+	priv->catalog_refs = g_hash_table_new_full (g_str_hash, 
+						    g_str_equal, 
+						    g_free, NULL);
+	priv->fragments = g_hash_table_new_full (g_direct_hash, 
+						 g_direct_equal, 
+						 NULL, g_free);
 
 	priv->unsaved_number = glade_id_allocator_allocate (get_unsaved_number_allocator ());	
 }
@@ -684,6 +765,62 @@ glade_project_class_init (GladeProjectClass *klass)
 			      G_TYPE_NONE,
 			      0);
 
+	/**
+	 * GladeProject::load-progress:
+	 * @gladeproject: the #GladeProject which received the signal.
+	 * @arg1: the number of toplevels read so far
+	 * @arg2: the number of toplevels in the file
+	 *
+	 * Emitted after each chunk of a progressive load, the widgets
+	 * read in the chunk have all been added to @gladeproject.
+	 */
+	glade_project_signals[LOAD_PROGRESS] =
+		g_signal_new ("load-progress",
+			      G_TYPE_FROM_CLASS (object_class),
+			      G_SIGNAL_RUN_FIRST,
+			      G_STRUCT_OFFSET (GladeProjectClass, load_progress),
+			      NULL, NULL,
+			      glade_marshal_VOID__UINT_UINT,
+			      G_TYPE_NONE,
+			      2,
+			      G_TYPE_UINT, G_TYPE_UINT);
+
+	/**
+	 * GladeProject::file-changed:
+	 * @gladeproject: the #GladeProject which received the signal.
+	 *
+	 * Emitted when the contents of @gladeproject's file were changed
+	 * by another program, see glade_project_get_file_changed().
+	 */
+	glade_project_signals[FILE_CHANGED] =
+		g_signal_new ("file-changed",
+			      G_TYPE_FROM_CLASS (object_class),
+			      G_SIGNAL_RUN_FIRST,
+			      G_STRUCT_OFFSET (GladeProjectClass, file_changed),
+			      NULL, NULL,
+			      g_cclosure_marshal_VOID__VOID,
+			      G_TYPE_NONE,
+			      0);
+
+	/**
+	 * GladeProject::resource-changed:
+	 * @gladeproject: the #GladeProject which received the signal.
+	 * @arg1: the file basename of the resource
+	 *
+	 * Emitted when a resource file used by @gladeproject was
+	 * changed by another program.
+	 */
+	glade_project_signals[RESOURCE_CHANGED] =
+		g_signal_new ("resource-changed",
+			      G_TYPE_FROM_CLASS (object_class),
+			      G_SIGNAL_RUN_FIRST,
+			      G_STRUCT_OFFSET (GladeProjectClass, resource_changed),
+			      NULL, NULL,
+			      g_cclosure_marshal_VOID__STRING,
+			      G_TYPE_NONE,
+			      1,
+			      G_TYPE_STRING);
+
 	g_object_class_install_property (object_class,
 					 PROP_MODIFIED,
 					 g_param_spec_boolean ("modified",
@@ -751,6 +888,79 @@ glade_project_get_readonly (GladeProject *project)
 	return project->priv->readonly;
 }
 
+static void
+glade_project_files_changed (const GList  *filenames,
+			     GladeProject *project)
+{
+	GladeFileDigest  digest;
+	gchar           *basename = g_path_get_basename (project->priv->path);
+	const GList     *l;
+	GList           *resources = NULL, *r;
+	gboolean         file_changed = FALSE;
+
+	for (l = filenames; l; l = l->next)
+	{
+		if (!strcmp ((gchar *)l->data, basename))
+		{
+			glade_file_digest (project->priv->path, &digest);
+
+			/* Only report contents we did not report yet */
+			if (glade_file_digest_equal (&digest, &project->priv->file_seen))
+				continue;
+			project->priv->file_seen = digest;
+
+			file_changed = 
+				!glade_file_digest_equal (&digest, &project->priv->file_digest);
+		}
+		else if (g_hash_table_lookup (project->priv->resource_refs, l->data))
+			resources = g_list_prepend (resources, l->data);
+	}
+	g_free (basename);
+
+	/* Handlers may reload or close the project, only
+	 * emit once we are done looking at it.
+	 */
+	g_object_ref (project);
+
+	resources = g_list_reverse (resources);
+	for (r = resources; r; r = r->next)
+		g_signal_emit (project, glade_project_signals [RESOURCE_CHANGED], 0, r->data);
+	if (file_changed)
+		g_signal_emit (project, glade_project_signals [FILE_CHANGED], 0);
+
+	g_list_free (resources);
+	g_object_unref (project);
+}
+
+/* Starts watching @project's file and resources for external changes,
+ * the file is expected to be unchanged since it was loaded or saved.
+ */
+static void
+glade_project_monitor (GladeProject *project)
+{
+	gchar *dirname;
+
+	if (project->priv->monitor)
+		glade_file_monitor_destroy (project->priv->monitor);
+
+	dirname = g_path_get_dirname (project->priv->path);
+	project->priv->monitor =
+		glade_file_monitor_new (dirname,
+					(GladeFileMonitorFunc)glade_project_files_changed,
+					project);
+	g_free (dirname);
+
+	if (project->priv->monitor)
+	{
+		glade_file_digest (project->priv->path, &project->priv->file_digest);
+		project->priv->file_seen = project->priv->file_digest;
+	}
+
+	/* Forget about any declined reload, the file is ours again */
+	project->priv->reload_declined = FALSE;
+	project->priv->mtime_declined  = 0;
+}
+
 /**
  * glade_project_new:
  *
@@ -772,6 +982,8 @@ glade_project_load_from_file (GladeProject *project, const gchar *path)
 	g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE); 
 	g_return_val_if_fail (path != NULL, FALSE);
 
+	GLADE_NOTE (LOAD, g_message ("Loading project %s", path));
+
 	interface = glade_parser_interface_new_from_file (path, NULL);
 
 	if (interface != NULL)
@@ -794,6 +1006,7 @@ glade_project_load_from_file (GladeProject *project, const gchar *path)
 	project->priv->modified = FALSE;
 		
 	project->priv->mtime = glade_util_get_file_mtime (project->priv->path, NULL);
+	glade_project_monitor (project);
 
 	return TRUE;
 }
@@ -815,43 +1028,62 @@ glade_project_selection_changed (GladeProject *project)
 }
 
 static void
-glade_project_on_widget_notify (GladeWidget *widget, GParamSpec *arg, GladeProject *project)
+glade_project_on_widget_renamed (GladeProject *project, GladeWidget *widget)
+{
+	const char *old_name = g_hash_table_lookup (project->priv->widget_old_names, widget);
+
+	glade_project_widget_name_changed (project, widget, old_name);
+	g_hash_table_insert (project->priv->widget_old_names, widget, g_strdup (glade_widget_get_name (widget)));
+}
+
+/**
+ * glade_project_widget_event:
+ * @project: a #GladeProject
+ * @widget: a #GladeWidget
+ * @event: what happened to @widget
+ *
+ * Tells @project about a change to @widget, this is called directly by
+ * #GladeWidget instead of the project connecting "notify" handlers to
+ * every widget it holds. Events for widgets that are not in @project
+ * are ignored.
+ */
+void
+glade_project_widget_event (GladeProject            *project,
+			    GladeWidget             *widget,
+			    GladeProjectWidgetEvent  event)
 {
-	g_return_if_fail (GLADE_IS_WIDGET (widget));
 	g_return_if_fail (GLADE_IS_PROJECT (project));
+	g_return_if_fail (GLADE_IS_WIDGET (widget));
 
-	switch (arg->name[0])
-	{
-	case 'n':
-		if (strcmp (arg->name, "name") == 0)
-		{
-			const char *old_name = g_hash_table_lookup (project->priv->widget_old_names, widget);
-			glade_project_widget_name_changed (project, widget, old_name);
-			g_hash_table_insert (project->priv->widget_old_names, widget, g_strdup (glade_widget_get_name (widget)));
-		}
+	if (widget->object == NULL ||
+	    !glade_project_has_object (project, widget->object))
+		return;
 
-	case 'p':
-		if (strcmp (arg->name, "project") == 0)
-			glade_project_remove_object (project, glade_widget_get_object (widget));
+	switch (event)
+	{
+		case GLADE_PROJECT_WIDGET_RENAMED:
+			glade_project_on_widget_renamed (project, widget);
+			break;
+		case GLADE_PROJECT_WIDGET_MOVED:
+			glade_project_remove_object (project, widget->object);
+			break;
+		default:
+			g_assert_not_reached ();
 	}
 }
 
 
 static void
-gp_sync_resources (GladeProject *project, 
-		   GladeProject *prev_project,
-		   GladeWidget  *gwidget,
-		   gboolean      remove)
+gp_sync_property_resources (GladeProject *project, 
+			    GladeProject *prev_project,
+			    GList        *properties,
+			    gboolean      remove)
 {
-	GList          *prop_list, *l;
+	GList          *l;
 	GladeProperty  *property;
 	gchar          *resource, *full_resource;
 
-	prop_list = g_list_copy (gwidget->properties);
-	prop_list = g_list_concat
-		(prop_list, g_list_copy (gwidget->packing_properties));
-
-	for (l = prop_list; l; l = l->next)
+	for (l = properties; l; l = l->next)
 	{
 		property = l->data;
 		if (property->klass->resource)
@@ -885,30 +1117,55 @@ gp_sync_resources (GladeProject *project,
 			g_value_unset (&value);
 		}
 	}
-	g_list_free (prop_list);
 }
 
+/* Syncs the resources of every widget in @widgets at once, this is
+ * called when a whole hierarchy was added to or removed from @project.
+ */
 static void
-glade_project_sync_resources_for_widget (GladeProject *project, 
-					 GladeProject *prev_project,
-					 GladeWidget  *gwidget,
-					 gboolean      remove)
-{
-	GList *children, *l;
-	GladeWidget *gchild;
-
-	children = glade_widget_adaptor_get_children
-		(gwidget->adaptor, gwidget->object);
-
-	for (l = children; l; l = l->next)
-		if ((gchild = 
-		     glade_widget_get_from_gobject (l->data)) != NULL)
-			glade_project_sync_resources_for_widget 
-				(project, prev_project, gchild, remove);
-	if (children)
-		g_list_free (children);
+glade_project_sync_resources (GladeProject *project, 
+			      GladeProject *prev_project,
+			      GList        *widgets,
+			      gboolean      remove)
+{
+	GladeWidget *gwidget;
+	GList       *l;
+
+	for (l = widgets; l; l = l->next)
+	{
+		gwidget = l->data;
 
-	gp_sync_resources (project, prev_project, gwidget, remove);
+		gp_sync_property_resources (project, prev_project, 
+					    gwidget->properties, remove);
+		gp_sync_property_resources (project, prev_project, 
+					    gwidget->packing_properties, remove);
+	}
+}
+
+/* Adds @delta to the number of objects of @adaptor and of its catalog */
+static void
+glade_project_count_adaptor (GladeProject       *project,
+			     GladeWidgetAdaptor *adaptor,
+			     gint                delta)
+{
+	const gchar *catalog = glade_widget_adaptor_get_catalog (adaptor);
+	guint        refs;
+
+	refs = GPOINTER_TO_UINT (g_hash_table_lookup (project->priv->adaptor_refs, adaptor)) + delta;
+	if (refs > 0)
+		g_hash_table_insert (project->priv->adaptor_refs, adaptor, GUINT_TO_POINTER (refs));
+	else
+		g_hash_table_remove (project->priv->adaptor_refs, adaptor);
+
+	if (catalog == NULL)
+		return;
+
+	refs = GPOINTER_TO_UINT (g_hash_table_lookup (project->priv->catalog_refs, catalog)) + delta;
+	if (refs > 0)
+		g_hash_table_insert (project->priv->catalog_refs, 
+				     g_strdup (catalog), GUINT_TO_POINTER (refs));
+	else
+		g_hash_table_remove (project->priv->catalog_refs, catalog);
 }
 
 /**
@@ -929,6 +1186,7 @@ glade_project_add_object (GladeProject *project,
 	GList         *list, *children;
 	GtkWindow     *transient_parent;
 	static gint    reentrancy_count = 0;
+	static GList  *added_widgets = NULL;
 
 	g_return_if_fail (GLADE_IS_PROJECT (project));
 	g_return_if_fail (G_IS_OBJECT      (object));
@@ -973,10 +1231,8 @@ glade_project_add_object (GladeProject *project,
 	g_hash_table_insert (project->priv->widget_old_names,
 			     gwidget, g_strdup (glade_widget_get_name (gwidget)));
 
-	g_signal_connect (G_OBJECT (gwidget), "notify",
-			  (GCallback) glade_project_on_widget_notify, project);
-
 	project->priv->objects = g_list_prepend (project->priv->objects, g_object_ref (object));
+	glade_project_count_adaptor (project, gwidget->adaptor, 1);
 	
 	g_signal_emit (G_OBJECT (project),
 		       glade_project_signals [ADD_WIDGET],
@@ -989,10 +1245,17 @@ glade_project_add_object (GladeProject *project,
 	/* Notify widget it was added to the project */
 	glade_widget_project_notify (gwidget, project);
 
+	added_widgets = g_list_prepend (added_widgets, gwidget);
+
 	/* Call this once at the end for every recursive call */
 	if (--reentrancy_count == 0)
-		glade_project_sync_resources_for_widget
-			(project, old_project, gwidget, FALSE);
+	{
+		GList *widgets = g_list_reverse (added_widgets);
+
+		added_widgets = NULL;
+		glade_project_sync_resources (project, old_project, widgets, FALSE);
+		g_list_free (widgets);
+	}
 }
 
 /**
@@ -1080,6 +1343,7 @@ glade_project_remove_object (GladeProject *project, GObject *object)
 	GladeWidget   *gwidget;
 	GList         *link, *list, *children;
 	static gint    reentrancy_count = 0;
+	static GList  *removed_widgets = NULL;
 	
 	g_return_if_fail (GLADE_IS_PROJECT (project));
 	g_return_if_fail (G_IS_OBJECT      (object));
@@ -1095,7 +1359,7 @@ glade_project_remove_object (GladeProject *project, GObject *object)
 
 	/* Notify widget is being removed from the project */
 	glade_widget_project_notify (gwidget, NULL);
-	
+
 	if ((children = 
 	     glade_widget_adaptor_get_children (gwidget->adaptor,
 						gwidget->object)) != NULL)
@@ -1107,12 +1371,15 @@ glade_project_remove_object (GladeProject *project, GObject *object)
 	
 	glade_project_selection_remove (project, object, TRUE);
 
+	g_hash_table_remove (project->priv->fragments, gwidget);
+
 	if ((link = g_list_find (project->priv->objects, object)) != NULL)
 	{
 		g_object_unref (object);
 		glade_project_release_widget_name (project, gwidget,
 						   glade_widget_get_name (gwidget));
 		project->priv->objects = g_list_delete_link (project->priv->objects, link);
+		glade_project_count_adaptor (project, gwidget->adaptor, -1);
 	}
 
 	g_signal_emit (G_OBJECT (project),
@@ -1120,9 +1387,17 @@ glade_project_remove_object (GladeProject *project, GObject *object)
 		       0,
 		       gwidget);
 
+	removed_widgets = g_list_prepend (removed_widgets, gwidget);
+
 	/* Call this once at the end for every recursive call */
 	if (--reentrancy_count == 0)
-		glade_project_sync_resources_for_widget (project, NULL, gwidget, TRUE);
+	{
+		GList *widgets = g_list_reverse (removed_widgets);
+
+		removed_widgets = NULL;
+		glade_project_sync_resources (project, NULL, widgets, TRUE);
+		g_list_free (widgets);
+	}
 }
 
 /**
@@ -1182,6 +1457,9 @@ glade_project_get_widget_by_name (GladeProject *project, const gchar *name)
 	g_return_val_if_fail (GLADE_IS_PROJECT (project), NULL);
 	g_return_val_if_fail (name != NULL, NULL);
 
+	if (project->priv->name_index)
+		return g_hash_table_lookup (project->priv->name_index, name);
+
 	for (list = project->priv->objects; list; list = list->next) {
 		GladeWidget *widget;
 
@@ -1432,37 +1710,69 @@ glade_project_selection_get (GladeProject *project)
 	return project->priv->selection;
 }
 
-static GList *
+static void
+required_libs_accum (const gchar  *catalog,
+		     gpointer      refs,
+		     GList       **list)
+{
+	*list = g_list_prepend (*list, g_strdup (catalog));
+}
+
+/**
+ * glade_project_required_libs:
+ * @project: a #GladeProject
+ *
+ * Returns: A newly allocated #GList of the names of the catalogs
+ *          used by objects in @project, sorted by name so that
+ *          saved files do not depend on hash table order; the
+ *          list and its strings should be freed.
+ */
+GList *
 glade_project_required_libs (GladeProject *project)
 {
-	GList       *required = NULL, *l, *ll;
-	GladeWidget *gwidget;
-	gboolean     listed;
+	GList *required = NULL;
+	g_return_val_if_fail (GLADE_IS_PROJECT (project), NULL);
 
-	for (l = project->priv->objects; l; l = l->next)
-	{
-		gchar *catalog = NULL;
+	g_hash_table_foreach (project->priv->catalog_refs, 
+			      (GHFunc)required_libs_accum, &required);
+	return g_list_sort (required, (GCompareFunc)strcmp);
+}
 
-		gwidget = glade_widget_get_from_gobject (l->data);
-		g_assert (gwidget);
+/**
+ * glade_project_get_catalog_count:
+ * @project: a #GladeProject
+ * @catalog: the name of a catalog
+ *
+ * Returns: the number of objects in @project whose adaptor
+ *          was declared by @catalog
+ */
+guint
+glade_project_get_catalog_count (GladeProject *project,
+				 const gchar  *catalog)
+{
+	g_return_val_if_fail (GLADE_IS_PROJECT (project), 0);
+	g_return_val_if_fail (catalog != NULL, 0);
 
-		g_object_get (gwidget->adaptor, "catalog", &catalog, NULL);
+	return GPOINTER_TO_UINT 
+		(g_hash_table_lookup (project->priv->catalog_refs, catalog));
+}
 
-		if (catalog)
-		{
-			listed = FALSE;
-			for (ll = required; ll; ll = ll->next)
-				if (!strcmp ((gchar *)ll->data, catalog))
-				{
-					listed = TRUE;
-					break;
-				}
-
-			if (!listed)
-				required = g_list_prepend (required, catalog);
-		}
-	}
-	return required;
+/**
+ * glade_project_get_adaptor_count:
+ * @project: a #GladeProject
+ * @adaptor: a #GladeWidgetAdaptor
+ *
+ * Returns: the number of objects in @project built by @adaptor
+ */
+guint
+glade_project_get_adaptor_count (GladeProject       *project,
+				 GladeWidgetAdaptor *adaptor)
+{
+	g_return_val_if_fail (GLADE_IS_PROJECT (project), 0);
+	g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), 0);
+
+	return GPOINTER_TO_UINT 
+		(g_hash_table_lookup (project->priv->adaptor_refs, adaptor));
 }
 
 #define GLADE_XML_COMMENT "Generated with "PACKAGE_NAME
@@ -1604,57 +1914,86 @@ loadable_interface (GladeInterface *interface, const gchar *path)
 	return loadable;
 }
 
+/**
+ * glade_project_add_object_reference:
+ * @project: a #GladeProject that is loading
+ * @property: an object #GladeProperty
+ * @value: the serialized object or object list
+ *
+ * Defers setting @property to the objects named in @value
+ * until all of @project's widgets have been read.
+ */
+void
+glade_project_add_object_reference (GladeProject  *project,
+				    GladeProperty *property,
+				    const gchar   *value)
+{
+	GladePendingReference *reference;
+
+	g_return_if_fail (GLADE_IS_PROJECT (project));
+	g_return_if_fail (GLADE_IS_PROPERTY (property));
+
+	reference           = g_new (GladePendingReference, 1);
+	reference->property = g_object_ref (property);
+	reference->value    = g_strdup (value);
+
+	project->priv->pending_references = 
+		g_list_prepend (project->priv->pending_references, reference);
+}
+
 static void 
 glade_project_fix_object_props (GladeProject *project)
 {
-	GList         *l, *ll;
-	GValue        *value;
-	GladeWidget   *gwidget;
-	GladeProperty *property;
-	gchar         *txt;
+	GladePendingReference *reference;
+	GList                 *l;
+	GValue                *value;
+	GladeWidget           *gwidget;
 
+	if (project->priv->pending_references == NULL)
+		return;
+
+	/* Resolve names with one lookup each */
+	project->priv->name_index = 
+		g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
 	for (l = project->priv->objects; l; l = l->next)
 	{
 		gwidget = glade_widget_get_from_gobject (l->data);
+		if (!g_hash_table_lookup (project->priv->name_index, gwidget->name))
+			g_hash_table_insert (project->priv->name_index, 
+					     g_strdup (gwidget->name), gwidget);
+	}
 
-		for (ll = gwidget->properties; ll; ll = ll->next)
-		{
-			property = GLADE_PROPERTY (ll->data);
+	project->priv->pending_references = 
+		g_list_reverse (project->priv->pending_references);
 
-			if (glade_property_class_is_object (property->klass) &&
-			    (txt = g_object_get_data (G_OBJECT (property), 
-						      "glade-loaded-object")) != NULL)
-			{
-				/* Parse the object list and set the property to it
-				 * (this magicly works for both objects & object lists)
-				 */
-				value = glade_property_class_make_gvalue_from_string
-					(property->klass, txt, project);
-				
-				glade_property_set_value (property, value);
+	for (l = project->priv->pending_references; l; l = l->next)
+	{
+		reference = l->data;
+
+		/* Parse the object list and set the property to it
+		 * (this magicly works for both objects & object lists)
+		 */
+		value = glade_property_class_make_gvalue_from_string
+			(reference->property->klass, reference->value, project);
 				
-				g_value_unset (value);
-				g_free (value);
+		glade_property_set_value (reference->property, value);
 				
-				g_object_set_data (G_OBJECT (property), 
-						   "glade-loaded-object", NULL);
-			}
-		}
+		g_value_unset (value);
+		g_free (value);
 	}
+
+	g_hash_table_destroy (project->priv->name_index);
+	project->priv->name_index = NULL;
+
+	glade_project_free_references (project);
 }
 
+/* Prepares @project to read the toplevels of @interface */
 static gboolean
-glade_project_load_from_interface (GladeProject   *project,
-				   GladeInterface *interface,
-				   const gchar    *path)
+glade_project_load_begin (GladeProject   *project,
+			  GladeInterface *interface,
+			  const gchar    *path)
 {
-	GladeWidget  *widget;
-	guint         i;
-
-	g_return_val_if_fail (project != NULL, FALSE);
-	g_return_val_if_fail (interface != NULL, FALSE);
-	g_return_val_if_fail (path != NULL, FALSE);
-
 	if (loadable_interface (interface, path) == FALSE)
 		return FALSE;
 
@@ -1662,31 +2001,65 @@ glade_project_load_from_interface (GladeProject   *project,
 	
 	project->priv->selection = NULL;
 	project->priv->objects = NULL;
-	project->priv->loading = TRUE;
 
 	/* keep a comment */
 	if (interface->comment)
 		project->priv->comment = g_strdup (interface->comment);
-	
-	for (i = 0; i < interface->n_toplevels; ++i)
+
+	project->priv->load_interface = interface;
+	project->priv->load_next      = 0;
+
+	return TRUE;
+}
+
+/* Reads toplevels until all are read or @slice seconds have passed
+ * (a negative @slice reads them all), returns whether any are left.
+ *
+ * The project is only marked as loading while the chunk is read, the
+ * project can be edited between chunks and such edits must be verified,
+ * undoable and mark the project as modified like any other.
+ */
+static gboolean
+glade_project_load_chunk (GladeProject *project,
+			  gdouble       slice)
+{
+	GladeInterface *interface = project->priv->load_interface;
+	GladeWidget    *widget;
+	GTimer         *timer = g_timer_new ();
+
+	project->priv->loading = TRUE;
+
+	while (project->priv->load_next < interface->n_toplevels)
 	{
-		widget = glade_widget_read ((gpointer) project, interface->toplevels[i]);
+		widget = glade_widget_read ((gpointer) project, 
+					    interface->toplevels[project->priv->load_next++]);
 		
 		if (!widget)
-		{
 			g_warning ("Failed to read a <widget> tag");
-			continue;
-		}
+		else
+			glade_project_add_object (project, NULL, widget->object);
 
-		glade_project_add_object (project, NULL, widget->object);
+		if (slice >= 0 && g_timer_elapsed (timer, NULL) >= slice)
+			break;
 	}
+	g_timer_destroy (timer);
 
-	/* Reset project status here too so that you get a clean
-	 * slate after calling glade_project_open().
-	 */
-	project->priv->modified = FALSE;
 	project->priv->loading = FALSE;
 
+	GLADE_NOTE (LOAD, g_message ("Read %d of %d toplevels", 
+				     project->priv->load_next, interface->n_toplevels));
+
+	g_signal_emit (project, glade_project_signals [LOAD_PROGRESS], 0,
+		       project->priv->load_next, interface->n_toplevels);
+
+	return project->priv->load_next < interface->n_toplevels;
+}
+
+static void
+glade_project_load_end (GladeProject *project)
+{
+	project->priv->load_interface = NULL;
+
 	/* Emit "parse-finished" signal */
 	g_signal_emit (project, glade_project_signals [PARSE_FINISHED], 0);
 	
@@ -1694,10 +2067,123 @@ glade_project_load_from_interface (GladeProject   *project,
 	 * and fix'em all ('cause they probably weren't found)
 	 */
 	glade_project_fix_object_props (project);
+}
+
+static gboolean
+glade_project_load_from_interface (GladeProject   *project,
+				   GladeInterface *interface,
+				   const gchar    *path)
+{
+	g_return_val_if_fail (project != NULL, FALSE);
+	g_return_val_if_fail (interface != NULL, FALSE);
+	g_return_val_if_fail (path != NULL, FALSE);
+
+	if (glade_project_load_begin (project, interface, path) == FALSE)
+		return FALSE;
+
+	glade_project_load_chunk (project, -1);
+
+	/* Reset project status here too so that you get a clean
+	 * slate after calling glade_project_open().
+	 */
+	project->priv->modified = FALSE;
+
+	glade_project_load_end (project);
 	
 	return TRUE;	
 }
 
+static gboolean
+glade_project_load_idle (GladeProject *project)
+{
+	GladeInterface *interface = project->priv->load_interface;
+
+	if (glade_project_load_chunk (project, GLADE_PROJECT_LOAD_SLICE))
+		return TRUE;
+
+	project->priv->load_id = 0;
+	glade_project_load_end (project);
+	glade_parser_interface_destroy (interface);
+
+	return FALSE;
+}
+
+/**
+ * glade_project_load_progressive:
+ * @path: the path of a glade file
+ * 
+ * Opens a project at the given path and reads its toplevels in
+ * time sliced chunks from the main loop, #GladeProject::load-progress
+ * is emitted after every chunk and #GladeProject::parse-finished
+ * once all of them are read; use glade_project_cancel_load() to
+ * stop reading.
+ *
+ * Returns: a new #GladeProject for the opened project on success, %NULL on 
+ *          failure
+ */
+GladeProject *
+glade_project_load_progressive (const gchar *path)
+{
+	GladeProject   *project;
+	GladeInterface *interface;
+	
+	g_return_val_if_fail (path != NULL, NULL);
+
+	GLADE_NOTE (LOAD, g_message ("Loading project %s progressively", path));
+
+	if ((interface = glade_parser_interface_new_from_file (path, NULL)) == NULL)
+		return NULL;
+	
+	project = glade_project_new ();
+
+	if (glade_project_load_begin (project, interface, path) == FALSE)
+	{
+		glade_parser_interface_destroy (interface);
+		g_object_unref (project);
+		return NULL;
+	}
+
+	if (glade_util_file_is_writeable (project->priv->path) == FALSE)
+		glade_project_set_readonly (project, TRUE);
+
+	/* The file was read above, not when the last chunk is */
+	project->priv->mtime = glade_util_get_file_mtime (project->priv->path, NULL);
+	glade_project_monitor (project);
+
+	project->priv->load_id = 
+		g_idle_add_full (G_PRIORITY_DEFAULT_IDLE, 
+				 (GSourceFunc)glade_project_load_idle, project, NULL);
+
+	return project;
+}
+
+/**
+ * glade_project_cancel_load:
+ * @project: a #GladeProject
+ * 
+ * Stops a load started by glade_project_load_progressive(), @project
+ * only contains the toplevels read so far and is meant to be closed.
+ */
+void
+glade_project_cancel_load (GladeProject *project)
+{
+	g_return_if_fail (GLADE_IS_PROJECT (project));
+
+	if (project->priv->load_id == 0)
+		return;
+
+	GLADE_NOTE (LOAD, g_message ("Cancelled loading %s", project->priv->path));
+
+	g_source_remove (project->priv->load_id);
+	project->priv->load_id = 0;
+
+	glade_parser_interface_destroy (project->priv->load_interface);
+	project->priv->load_interface = NULL;
+
+	/* References to toplevels that were never read stay unresolved */
+	glade_project_free_references (project);
+}
+
 /**
  * glade_project_load:
  * @path:
@@ -1735,8 +2221,7 @@ glade_project_move_resources (GladeProject *project,
 			      const gchar  *old_dir,
 			      const gchar  *new_dir)
 {
-	GList *list, *resources;
-	gchar *old_name, *new_name;
+	GList *list, *resources, *old_names = NULL, *new_names = NULL;
 
 	if (old_dir == NULL || /* <-- Cant help you :( */
 	    new_dir == NULL)   /* <-- Unlikely         */
@@ -1748,15 +2233,107 @@ glade_project_move_resources (GladeProject *project,
 	
 	for (list = resources; list; list = list->next)
 	{
-		old_name = g_build_filename 
-			(old_dir, (gchar *)list->data, NULL);
-		new_name = g_build_filename 
-			(new_dir, (gchar *)list->data, NULL);
-		glade_util_copy_file (old_name, new_name);
-		g_free (old_name);
-		g_free (new_name);
+		old_names = g_list_prepend 
+			(old_names, g_build_filename (old_dir, (gchar *)list->data, NULL));
+		new_names = g_list_prepend 
+			(new_names, g_build_filename (new_dir, (gchar *)list->data, NULL));
 	}
 	g_list_free (resources);
+
+	glade_util_copy_files (old_names, new_names);
+
+	g_list_foreach (old_names, (GFunc)g_free, NULL);
+	g_list_foreach (new_names, (GFunc)g_free, NULL);
+	g_list_free (old_names);
+	g_list_free (new_names);
+}
+
+/**
+ * glade_project_widget_changed:
+ * @project: a #GladeProject
+ * @widget: a #GladeWidget in @project
+ *
+ * Notes that @widget's properties, signals or children changed
+ * so that its toplevel is serialized again on the next save.
+ */
+void
+glade_project_widget_changed (GladeProject *project,
+			      GladeWidget  *widget)
+{
+	g_return_if_fail (GLADE_IS_PROJECT (project));
+	g_return_if_fail (GLADE_IS_WIDGET (widget));
+
+	while (widget->parent)
+		widget = widget->parent;
+
+	g_hash_table_remove (project->priv->fragments, widget);
+}
+
+/* Writes @project with the fragments of unchanged toplevels kept
+ * from the previous save, only the changed ones are serialized.
+ */
+static gboolean
+glade_project_save_fragments (GladeProject *project, const gchar *path, GError **error)
+{
+	GladeInterface  *interface = NULL;
+	GladeWidgetInfo *info;
+	GladeWidget     *widget;
+	GPtrArray       *infos;
+	GList           *list, *fragments = NULL;
+	const gchar     *name = NULL;
+	gchar           *fragment;
+	gboolean         ret = FALSE;
+
+	infos = g_ptr_array_new ();
+
+	for (list = project->priv->objects; list; list = list->next)
+	{
+		widget = glade_widget_get_from_gobject (list->data);
+
+		if (widget->parent != NULL)
+			continue;
+
+		if ((fragment = g_hash_table_lookup (project->priv->fragments, widget)) == NULL)
+		{
+			if (interface == NULL)
+				interface = glade_parser_interface_new ();
+
+			if ((info = glade_widget_write (widget, interface)) == NULL)
+			{
+				g_warning ("Could not write glade document\n");
+				goto out;
+			}
+			g_ptr_array_add (infos, info);
+
+			GLADE_NOTE (SAVE, g_message ("Serializing %s", widget->name));
+
+			fragment = glade_parser_widget_fragment (info);
+			g_hash_table_insert (project->priv->fragments, widget, fragment);
+		}
+
+		/* Toplevels are written in reverse order, the first
+		 * one written names the project.
+		 */
+		fragments = g_list_prepend (fragments, fragment);
+		name      = widget->name;
+	}
+
+	ret = glade_parser_dump_fragments (name, fragments, path, error);
+
+ out:
+	/* Let the interface free the infos */
+	if (interface)
+	{
+		interface->n_toplevels = infos->len;
+		interface->toplevels   = (GladeWidgetInfo **)g_ptr_array_free (infos, FALSE);
+		glade_parser_interface_destroy (interface);
+	}
+	else
+		g_ptr_array_free (infos, TRUE);
+
+	g_list_free (fragments);
+
+	return ret;
 }
 
 /**
@@ -1779,15 +2356,22 @@ glade_project_save (GladeProject *project, const gchar *path, GError **error)
 	g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE);
 	g_return_val_if_fail (path != NULL, FALSE);
 
-	interface = glade_project_write (project);
-	if (!interface)
+	GLADE_NOTE (SAVE, g_message ("Saving project %s", path));
+
+	if (glade_parser_dump_uses_fragments ())
+		ret = glade_project_save_fragments (project, path, error);
+	else
 	{
-		g_warning ("Could not write glade document\n");
-		return FALSE;
-	}
+		interface = glade_project_write (project);
+		if (!interface)
+		{
+			g_warning ("Could not write glade document\n");
+			return FALSE;
+		}
 
-	ret = glade_parser_interface_dump (interface, path, error);
-	glade_parser_interface_destroy (interface);
+		ret = glade_parser_interface_dump (interface, path, error);
+		glade_parser_interface_destroy (interface);
+	}
 
 	canonical_path = glade_util_canonical_path (path);
 	g_assert (canonical_path);
@@ -1816,6 +2400,7 @@ glade_project_save (GladeProject *project, const gchar *path, GError **error)
 				    !glade_util_file_is_writeable (project->priv->path));
 
 	project->priv->mtime = glade_util_get_file_mtime (project->priv->path, NULL);
+	glade_project_monitor (project);
 	
 	glade_project_set_modified (project, FALSE, NULL);
 
@@ -2120,17 +2705,36 @@ glade_project_resource_fullpath (GladeProject *project,
 }
 
 
+/* Adds a reference to @resource, returns whether it is new to the project */
 static gboolean
-find_resource_by_resource (GladeProperty *key,
-			   const gchar   *resource,
-			   const gchar   *resource_cmp)
+glade_project_ref_resource (GladeProject *project,
+			    const gchar  *resource)
 {
-	g_assert (resource);
-	g_assert (resource_cmp);
-	return (!strcmp (resource, resource_cmp));
+	guint refs = GPOINTER_TO_UINT 
+		(g_hash_table_lookup (project->priv->resource_refs, resource));
+
+	g_hash_table_insert (project->priv->resource_refs, 
+			     g_strdup (resource), GUINT_TO_POINTER (refs + 1));
+	return refs == 0;
 }
 
+/* Drops a reference to @resource, returns whether it left the project */
+static gboolean
+glade_project_unref_resource (GladeProject *project,
+			      const gchar  *resource)
+{
+	guint refs = GPOINTER_TO_UINT 
+		(g_hash_table_lookup (project->priv->resource_refs, resource));
 
+	if (refs > 1)
+	{
+		g_hash_table_insert (project->priv->resource_refs, 
+				     g_strdup (resource), GUINT_TO_POINTER (refs - 1));
+		return FALSE;
+	}
+	g_hash_table_remove (project->priv->resource_refs, resource);
+	return TRUE;
+}
 
 /**
  * glade_project_set_resource:
@@ -2170,9 +2774,7 @@ glade_project_set_resource (GladeProject  *project,
 	{
 		g_hash_table_remove (project->priv->resources, property);
 
-		if (g_hash_table_find (project->priv->resources,
-				       (GHRFunc)find_resource_by_resource,
-				       last_resource_dup) == NULL)
+		if (glade_project_unref_resource (project, last_resource_dup))
 			g_signal_emit (G_OBJECT (project),
 				       glade_project_signals [RESOURCE_REMOVED],
 				       0, last_resource_dup);
@@ -2207,9 +2809,7 @@ glade_project_set_resource (GladeProject  *project,
 		 */
 		if ((last_resource_dup == NULL || 
 		     strcmp (last_resource_dup, base_resource)) &&
-		    g_hash_table_find (project->priv->resources,
-				       (GHRFunc)find_resource_by_resource,
-				       base_resource) == NULL)
+		    glade_project_ref_resource (project, base_resource))
 			g_signal_emit (G_OBJECT (project),
 				       glade_project_signals [RESOURCE_ADDED],
 				       0, base_resource);
@@ -2221,11 +2821,11 @@ glade_project_set_resource (GladeProject  *project,
 }
 
 static void
-list_resources_accum (GladeProperty  *key,
-		      gchar          *value,
+list_resources_accum (gchar          *resource,
+		      gpointer        refs,
 		      GList         **list)
 {
-	*list = g_list_prepend (*list, value);
+	*list = g_list_prepend (*list, resource);
 }
 
 
@@ -2246,7 +2846,7 @@ glade_project_list_resources (GladeProject  *project)
 	GList *list = NULL;
 	g_return_val_if_fail (GLADE_IS_PROJECT (project), NULL);
 
-	g_hash_table_foreach (project->priv->resources, 
+	g_hash_table_foreach (project->priv->resource_refs, 
 			      (GHFunc)list_resources_accum, &list);
 	return list;
 }
@@ -2285,6 +2885,25 @@ glade_project_is_loading (GladeProject *project)
 	return project->priv->loading;
 }
 
+/**
+ * glade_project_is_reading:
+ * @project: A #GladeProject
+ *
+ * Unlike glade_project_is_loading(), which is only set while widgets
+ * are being read, this stays set between the chunks read by
+ * glade_project_load_progressive() until #GladeProject::parse-finished
+ * is emitted or the load is cancelled.
+ *
+ * Returns: Whether toplevels of the project file are still to be read
+ */
+gboolean
+glade_project_is_reading (GladeProject *project)
+{
+	g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE);
+	
+	return project->priv->load_interface != NULL;
+}
+
 time_t
 glade_project_get_file_mtime (GladeProject *project)
 {
@@ -2293,6 +2912,82 @@ glade_project_get_file_mtime (GladeProject *project)
 	return project->priv->mtime;
 }
 
+/**
+ * glade_project_get_file_changed:
+ * @project: a #GladeProject
+ *
+ * Returns: whether @project's file was changed by another program
+ *          since @project was loaded or saved
+ */
+gboolean
+glade_project_get_file_changed (GladeProject *project)
+{
+	g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE);
+
+	if (project->priv->path == NULL)
+		return FALSE;
+
+	/* Without a monitor, all we have is the modification time */
+	if (project->priv->monitor == NULL)
+		return glade_util_get_file_mtime (project->priv->path, NULL) > 
+			project->priv->mtime;
+
+	return !glade_file_digest_equal (&project->priv->file_seen,
+					 &project->priv->file_digest);
+}
+
+/**
+ * glade_project_decline_reload:
+ * @project: a #GladeProject
+ *
+ * Records that the user declined to reload the current contents of
+ * @project's file, see glade_project_get_reload_declined().
+ * glade_project_get_file_changed() is not affected: saving should
+ * still warn about overwriting the external changes.
+ */
+void
+glade_project_decline_reload (GladeProject *project)
+{
+	g_return_if_fail (GLADE_IS_PROJECT (project));
+
+	if (project->priv->path == NULL)
+		return;
+
+	if (project->priv->monitor == NULL)
+		project->priv->mtime_declined = 
+			glade_util_get_file_mtime (project->priv->path, NULL);
+	else
+	{
+		project->priv->file_declined   = project->priv->file_seen;
+		project->priv->reload_declined = TRUE;
+	}
+}
+
+/**
+ * glade_project_get_reload_declined:
+ * @project: a #GladeProject
+ *
+ * Returns: whether the user already declined to reload the current
+ *          contents of @project's file, since it was loaded or saved
+ */
+gboolean
+glade_project_get_reload_declined (GladeProject *project)
+{
+	g_return_val_if_fail (GLADE_IS_PROJECT (project), FALSE);
+
+	if (project->priv->path == NULL)
+		return FALSE;
+
+	if (project->priv->monitor == NULL)
+		return project->priv->mtime_declined != 0 &&
+			glade_util_get_file_mtime (project->priv->path, NULL) == 
+			project->priv->mtime_declined;
+
+	return project->priv->reload_declined &&
+		glade_file_digest_equal (&project->priv->file_seen,
+					 &project->priv->file_declined);
+}
+
 const GList *
 glade_project_get_objects (GladeProject *project)
 {
@@ -2333,3 +3028,202 @@ glade_project_get_modified (GladeProject *project)
 	return project->priv->modified;
 }
 
+
+/* Memory accounted to the objects of one adaptor */
+typedef struct {
+	GladeWidgetAdaptor *adaptor;
+	guint               n_widgets;
+	guint               n_properties;
+	guint               n_signals;
+	guint               n_tables;
+	gsize               bytes;
+} GladeMemoryStats;
+
+/* Memory accounted to each structure, over all adaptors */
+typedef struct {
+	gsize widgets;
+	gsize properties;
+	gsize values;
+	gsize lists;
+	gsize signals;
+	gsize strings;
+	guint tables;
+} GladeMemoryTotals;
+
+static gsize
+glade_memory_string (const gchar *string)
+{
+	return string ? strlen (string) + 1 : 0;
+}
+
+static void
+glade_memory_count_properties (GList             *properties,
+			       GladeMemoryStats  *stats,
+			       GladeMemoryTotals *totals)
+{
+	GladeProperty *property;
+	GList         *l;
+	gsize          strings;
+
+	for (l = properties; l; l = l->next)
+	{
+		property = l->data;
+
+		strings = glade_memory_string (property->i18n_comment);
+		if (G_VALUE_HOLDS_STRING (property->value))
+			strings += glade_memory_string (g_value_get_string (property->value));
+
+		stats->n_properties++;
+		stats->bytes += sizeof (GladeProperty) + sizeof (GValue) + sizeof (GList) + strings;
+
+		totals->properties += sizeof (GladeProperty);
+		totals->values     += sizeof (GValue);
+		totals->lists      += sizeof (GList);
+		totals->strings    += strings;
+	}
+}
+
+static void
+glade_memory_count_signals (const gchar       *name,
+			    GPtrArray         *signals,
+			    gpointer          *data)
+{
+	GladeMemoryStats  *stats  = data[0];
+	GladeMemoryTotals *totals = data[1];
+	GladeSignal       *signal;
+	gsize              strings;
+	guint              i;
+
+	stats->bytes     += sizeof (GPtrArray) + signals->len * sizeof (gpointer) + 
+		glade_memory_string (name);
+	totals->signals  += sizeof (GPtrArray) + signals->len * sizeof (gpointer);
+	totals->strings  += glade_memory_string (name);
+
+	for (i = 0; i < signals->len; i++)
+	{
+		signal  = g_ptr_array_index (signals, i);
+		strings = 
+			glade_memory_string (signal->name) +
+			glade_memory_string (signal->handler) +
+			glade_memory_string (signal->userdata);
+
+		stats->n_signals++;
+		stats->bytes    += sizeof (GladeSignal) + strings;
+		totals->signals += sizeof (GladeSignal);
+		totals->strings += strings;
+	}
+}
+
+static gint
+glade_memory_stats_compare (GladeMemoryStats *a,
+			    GladeMemoryStats *b)
+{
+	return a->bytes < b->bytes ? 1 : (a->bytes > b->bytes ? -1 : 0);
+}
+
+static void
+glade_memory_stats_accum (GladeWidgetAdaptor *adaptor,
+			  GladeMemoryStats   *stats,
+			  GList             **list)
+{
+	*list = g_list_insert_sorted (*list, stats, 
+				      (GCompareFunc)glade_memory_stats_compare);
+}
+
+/**
+ * glade_project_memory_report:
+ * @project: a #GladeProject
+ *
+ * Prints an estimate of the memory used by the widgets of @project,
+ * per adaptor and per structure. Only the structures Glade allocates
+ * are counted, not the runtime objects nor hash table internals.
+ */
+void
+glade_project_memory_report (GladeProject *project)
+{
+	GladeMemoryTotals  totals = { 0, };
+	GladeMemoryStats  *stats;
+	GHashTable        *adaptors;
+	GladeWidget       *gwidget;
+	GList             *l, *sorted = NULL;
+	gpointer           data[2];
+	gchar             *name;
+	gsize              strings, total = 0;
+
+	g_return_if_fail (GLADE_IS_PROJECT (project));
+
+	adaptors = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+
+	for (l = project->priv->objects; l; l = l->next)
+	{
+		gwidget = glade_widget_get_from_gobject (l->data);
+
+		if ((stats = g_hash_table_lookup (adaptors, gwidget->adaptor)) == NULL)
+		{
+			stats = g_new0 (GladeMemoryStats, 1);
+			stats->adaptor = gwidget->adaptor;
+			g_hash_table_insert (adaptors, gwidget->adaptor, stats);
+		}
+
+		strings = 
+			glade_memory_string (gwidget->name) + 
+			glade_memory_string (gwidget->internal);
+
+		stats->n_widgets++;
+		stats->bytes += sizeof (GladeWidget) + sizeof (GList) + strings;
+
+		totals.widgets += sizeof (GladeWidget);
+		totals.lists   += sizeof (GList);
+		totals.strings += strings;
+
+		glade_memory_count_properties (gwidget->properties, stats, &totals);
+		glade_memory_count_properties (gwidget->packing_properties, stats, &totals);
+
+		data[0] = stats;
+		data[1] = &totals;
+		g_hash_table_foreach (gwidget->signals, 
+				      (GHFunc)glade_memory_count_signals, data);
+		stats->n_tables++;
+
+		/* prop_refs links, plus the private index over them */
+		if (gwidget->prop_refs)
+		{
+			stats->bytes += g_list_length (gwidget->prop_refs) * sizeof (GList);
+			totals.lists += g_list_length (gwidget->prop_refs) * sizeof (GList);
+			stats->n_tables++;
+		}
+	}
+
+	g_hash_table_foreach (adaptors, (GHFunc)glade_memory_stats_accum, &sorted);
+
+	name = glade_project_get_name (project);
+	g_print ("Memory report for %s (%d objects)\n\n", 
+		 name, g_list_length (project->priv->objects));
+	g_free (name);
+
+	g_print ("  %-32s %8s %10s %8s %7s %10s\n",
+		 "Adaptor", "Widgets", "Properties", "Signals", "Tables", "Bytes");
+	for (l = sorted; l; l = l->next)
+	{
+		stats = l->data;
+		g_print ("  %-32s %8u %10u %8u %7u %10lu\n",
+			 stats->adaptor->name, 
+			 stats->n_widgets, stats->n_properties, 
+			 stats->n_signals, stats->n_tables, 
+			 (gulong)stats->bytes);
+
+		totals.tables += stats->n_tables;
+		total         += stats->bytes;
+	}
+	g_list_free (sorted);
+	g_hash_table_destroy (adaptors);
+
+	g_print ("\n  %-32s %10lu\n", "GladeWidget",   (gulong)totals.widgets);
+	g_print ("  %-32s %10lu\n",   "GladeProperty", (gulong)totals.properties);
+	g_print ("  %-32s %10lu\n",   "GValue",        (gulong)totals.values);
+	g_print ("  %-32s %10lu\n",   "GList",         (gulong)totals.lists);
+	g_print ("  %-32s %10lu\n",   "GladeSignal",   (gulong)totals.signals);
+	g_print ("  %-32s %10lu\n",   "Strings",       (gulong)totals.strings);
+	g_print ("  %-32s %10u (not counted)\n", "Hash tables", totals.tables);
+	g_print ("  %-32s %10lu\n\n", "Total",         (gulong)total);
+}
@@ -17,6 +17,13 @@ G_BEGIN_DECLS
 typedef struct _GladeProjectPrivate  GladeProjectPrivate;
 typedef struct _GladeProjectClass    GladeProjectClass;
 
+/* What happened to a widget, see glade_project_widget_event() */
+typedef enum
+{
+	GLADE_PROJECT_WIDGET_RENAMED,
+	GLADE_PROJECT_WIDGET_MOVED
+} GladeProjectWidgetEvent;
+
 struct _GladeProject
 {
 	GObject parent_instance;
@@ -54,6 +61,13 @@ struct _GladeProjectClass
 	void          (*resource_removed)    (GladeProject *project,
 					      const gchar  *resource);
 	void          (*parse_finished)      (GladeProject *project);
+	void          (*load_progress)       (GladeProject *project,
+					      guint         loaded,
+					      guint         total);
+
+	void          (*file_changed)        (GladeProject *project);
+	void          (*resource_changed)    (GladeProject *project,
+					      const gchar  *resource);
 };
 
 
@@ -63,6 +77,10 @@ GladeProject  *glade_project_new                 (void);
 
 gboolean       glade_project_load_from_file      (GladeProject *project, const gchar *path);
 
+GladeProject  *glade_project_load_progressive    (const gchar  *path);
+
+void           glade_project_cancel_load         (GladeProject *project);
+
 GladeProject  *glade_project_load                (const gchar  *path);
 
 gboolean       glade_project_save                (GladeProject *project, 
@@ -105,6 +123,17 @@ gboolean       glade_project_has_object          (GladeProject *project, GObject
 
 GladeWidget   *glade_project_get_widget_by_name  (GladeProject *project, const char  *name);
 
+void           glade_project_widget_changed      (GladeProject *project,
+						 GladeWidget  *widget);
+
+void           glade_project_widget_event        (GladeProject            *project,
+						  GladeWidget             *widget,
+						  GladeProjectWidgetEvent  event);
+
+void           glade_project_add_object_reference (GladeProject  *project,
+						   GladeProperty *property,
+						   const gchar   *value);
+
 char          *glade_project_new_widget_name     (GladeProject *project, const char  *base_name);
 
 void           glade_project_widget_name_changed (GladeProject *project, GladeWidget *widget,
@@ -145,12 +174,28 @@ void           glade_project_set_resource         (GladeProject  *project,
 
 GList         *glade_project_list_resources       (GladeProject  *project);
 
+guint          glade_project_get_adaptor_count    (GladeProject       *project,
+						   GladeWidgetAdaptor *adaptor);
+
+guint          glade_project_get_catalog_count    (GladeProject  *project,
+						   const gchar   *catalog);
+
+GList         *glade_project_required_libs        (GladeProject  *project);
+
 gchar         *glade_project_resource_fullpath    (GladeProject  *project,
 						   const gchar   *resource);
  
 gboolean       glade_project_is_loading           (GladeProject *project);
+
+gboolean       glade_project_is_reading           (GladeProject *project);
  
 time_t         glade_project_get_file_mtime       (GladeProject *project);
+
+gboolean       glade_project_get_file_changed     (GladeProject *project);
+
+void           glade_project_decline_reload       (GladeProject *project);
+
+gboolean       glade_project_get_reload_declined  (GladeProject *project);
   
 guint          glade_project_get_instance_count   (GladeProject *project);
 
@@ -158,6 +203,8 @@ void           glade_project_set_instance_count   (GladeProject *project, guint
 
 gboolean       glade_project_get_modified         (GladeProject *project);
 
+void           glade_project_memory_report        (GladeProject *project);
+
 G_END_DECLS
 
 #endif /* __GLADE_PROJECT_H__ */
@@ -96,9 +96,8 @@ glade_property_dup_impl (GladeProperty *template_prop, GladeWidget *widget)
 	property->widget  = widget;
 	property->value   = g_new0 (GValue, 1);
 
-	property->insensitive_tooltip =
-		template_prop->insensitive_tooltip ?
-		g_strdup (template_prop->insensitive_tooltip) : NULL;
+	/* Interned, see glade_property_set_sensitive() */
+	property->insensitive_tooltip = template_prop->insensitive_tooltip;
 
 	g_value_init (property->value, template_prop->value->g_type);
 	g_value_copy (template_prop->value, property->value);
@@ -149,8 +148,7 @@ glade_property_update_prop_refs (GladeProperty *property,
 		new_list = g_value_dup_boxed (new_value);
 
 		/* Diff up the GList */
-		removed = glade_util_removed_from_list (old_list, new_list);
-		added   = glade_util_added_in_list     (old_list, new_list);
+		glade_util_diff_lists (old_list, new_list, &added, &removed);
 
 		/* Adjust the appropriate prop refs */
 		for (list = removed; list; list = list->next)
@@ -210,6 +208,17 @@ glade_property_verify (GladeProperty *property, const GValue *value)
 	}
 }
 
+/* Lets the project serialize the toplevel of @property's widget
+ * again on the next save, for anything glade_property_write() uses.
+ */
+static void
+glade_property_changed (GladeProperty *property)
+{
+	if (property->widget && property->widget->project)
+		glade_project_widget_changed (property->widget->project,
+					      property->widget);
+}
+
 static void
 glade_property_set_value_impl (GladeProperty *property, const GValue *value)
 {
@@ -218,16 +227,15 @@ glade_property_set_value_impl (GladeProperty *property, const GValue *value)
 	gboolean      changed = FALSE;
 	GValue old_value = {0,};
 
-#if 0
+	GLADE_NOTE (COMMAND,
 	{
 		gchar *str = glade_property_class_make_string_from_gvalue
 			(property->klass, value);
-		g_print ("Setting property %s on %s to %s\n",
-			 property->klass->id,
-			 property->widget ? property->widget->name : "unknown", str);
+		g_message ("Setting property %s on %s to %s",
+			   property->klass->id,
+			   property->widget ? property->widget->name : "unknown", str);
 		g_free (str);
-	}
-#endif
+	});
 
 	if (!g_value_type_compatible (G_VALUE_TYPE (property->value), G_VALUE_TYPE (value)))
 	{
@@ -271,6 +279,8 @@ glade_property_set_value_impl (GladeProperty *property, const GValue *value)
 
 	if (changed && property->widget)
 	{
+		glade_property_changed (property);
+
 		g_signal_emit (G_OBJECT (property),
 			       glade_property_signals[VALUE_CHANGED],
 			       0, &old_value, property->value);
@@ -783,9 +793,7 @@ glade_property_read_normal (GladeProperty      *property,
 				 * (i.e. lookup the actual objects after they've been parsed and
 				 * are present).
 				 */
-				g_object_set_data_full (G_OBJECT (property), 
-							"glade-loaded-object", 
-							g_strdup (pinfo->value), g_free);
+				glade_project_add_object_reference (project, property, pinfo->value);
 			}
 			else
 			{
@@ -909,11 +917,10 @@ glade_property_read_atk_relation (GladeProperty      *property,
 	 * (i.e. lookup the actual objects after they've been parsed and
 	 * are present).
 	 */
-	if (property)
-	{
-		g_object_set_data_full (G_OBJECT (property), "glade-loaded-object", 
-					g_strdup (string), g_free);
-	}
+	if (property && string)
+		glade_project_add_object_reference (project, property, string);
+
+	g_free (string);
 
 	return NULL;
 }
@@ -1527,10 +1534,16 @@ glade_property_i18n_set_comment (GladeProperty *property,
 				 const gchar   *str)
 {
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
+
+	if (property->i18n_comment == str ||
+	    (property->i18n_comment && str && !strcmp (property->i18n_comment, str)))
+		return;
+
 	if (property->i18n_comment)
 		g_free (property->i18n_comment);
 
 	property->i18n_comment = g_strdup (str);
+	glade_property_changed (property);
 	g_object_notify (G_OBJECT (property), "i18n-comment");
 }
 
@@ -1546,6 +1559,8 @@ glade_property_i18n_set_translatable (GladeProperty *property,
 				      gboolean       translatable)
 {
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
+	if (property->i18n_translatable != translatable)
+		glade_property_changed (property);
 	property->i18n_translatable = translatable;
 	g_object_notify (G_OBJECT (property), "i18n-translatable");
 }
@@ -1562,6 +1577,8 @@ glade_property_i18n_set_has_context (GladeProperty *property,
 				     gboolean       has_context)
 {
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
+	if (property->i18n_has_context != has_context)
+		glade_property_changed (property);
 	property->i18n_has_context = has_context;
 	g_object_notify (G_OBJECT (property), "i18n-has-context");
 }
@@ -1583,10 +1600,11 @@ glade_property_set_sensitive (GladeProperty *property,
 	/* reason is only why we're disableing it */
 	if (sensitive == FALSE)
 	{
-		if (property->insensitive_tooltip)
-			g_free (property->insensitive_tooltip);
+		/* There are only a handful of reasons, shared by every
+		 * property they apply to.
+		 */
 		property->insensitive_tooltip =
-			g_strdup (reason);
+			(gchar *)g_intern_string (reason);
 	}
 
 	if (property->sensitive != sensitive)
@@ -1629,6 +1647,9 @@ glade_property_set_save_always (GladeProperty      *property,
 {
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
 
+	if (property->save_always != setting)
+		glade_property_changed (property);
+
 	property->save_always = setting;
 }
 
@@ -1653,6 +1674,9 @@ glade_property_set_enabled (GladeProperty *property,
 {
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
 
+	if (property->enabled != enabled)
+		glade_property_changed (property);
+
 	property->enabled = enabled;
 	if (enabled)
 		glade_property_sync (property);
@@ -37,7 +37,8 @@ struct _GladeProperty
 					* property is "optional" this takes precedence).
 					*/
 	gchar              *insensitive_tooltip; /* Tooltip to display when in insensitive state
-						  * (used to explain why the property is insensitive)
+						  * (used to explain why the property is insensitive),
+						  * an interned string
 						  */
 
 	gboolean            enabled;   /* Enabled is a flag that is used for GladeProperties
@@ -22,6 +22,10 @@
  
 #include <config.h>
 
+#ifdef HAVE_COPY_FILE_RANGE
+#  define _GNU_SOURCE
+#endif
+
 /**
  * SECTION:glade-utils
  * @Title: Glade Utils
@@ -41,6 +45,7 @@
 #include "glade-property-class.h"
 #include "glade-clipboard.h"
 #include "glade-fixed.h"
+#include "glade-design-layout.h"
 
 #include <string.h>
 #include <gdk/gdkkeysyms.h>
@@ -49,6 +54,17 @@
 #include <glib/gstdio.h>
 #include <errno.h>
 
+#ifdef G_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#  ifdef HAVE_LINUX_FS_H
+#  include <linux/fs.h>
+#  endif
+#endif
+
 #ifdef G_OS_WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -56,7 +72,8 @@
 #endif
 
 #define GLADE_UTIL_SELECTION_NODE_SIZE 7
-#define GLADE_UTIL_COPY_BUFFSIZE       1024
+#define GLADE_UTIL_COPY_BUFFSIZE       65536
+#define GLADE_UTIL_COPY_THREADS        4
 
 #define GLADE_DEVHELP_ICON_NAME           "devhelp"
 #define GLADE_DEVHELP_FALLBACK_ICON_FILE  "devhelp.png"
@@ -742,6 +759,239 @@ glade_util_can_draw_nodes (GtkWidget *sel_widget, GdkWindow *sel_win,
 	return FALSE;
 }
 
+/* Selection geometry cache.
+ *
+ * Node rectangles are kept relative to an anchor window and grouped by
+ * it, sorted by their y position, so that an expose only has to look at
+ * the nodes overlapping its damaged area. The anchor of widgets in a
+ * GladeDesignLayout is the window the layout draws in (the design view
+ * scrolls it, the positions in it stay the same), otherwise it is the
+ * toplevel window. The cache is dropped whenever the selection changes,
+ * a selected widget gets reallocated or a layout anchoring cached nodes
+ * gets reallocated (which any relayout below it goes through).
+ *
+ * Widgets placed inside a viewport of the project are not cached since
+ * scrolling moves their windows without reallocating them; they are
+ * resolved at expose time instead.
+ */
+typedef struct {
+	GtkWidget    *widget;
+	GdkRectangle  area;
+} GladeUtilNode;
+
+typedef struct {
+	GArray *nodes;      /* GladeUtilNode, sorted by area.y */
+	gint    max_height; /* tallest node in this toplevel */
+} GladeUtilNodeIndex;
+
+static GHashTable *glade_util_node_cache    = NULL;
+static GList      *glade_util_node_volatile = NULL;
+static GList      *glade_util_node_layouts  = NULL; /* layouts anchoring cached nodes */
+
+static void glade_util_selection_size_allocate  (GtkWidget     *widget,
+						 GtkAllocation *allocation,
+						 gpointer       data);
+static void glade_util_selection_layout_destroy (GtkObject     *object,
+						 gpointer       data);
+
+static void
+glade_util_node_index_free (GladeUtilNodeIndex *index)
+{
+	g_array_free (index->nodes, TRUE);
+	g_free (index);
+}
+
+static gint
+glade_util_node_compare (gconstpointer a, gconstpointer b)
+{
+	const GladeUtilNode *node_a = a, *node_b = b;
+
+	return node_a->area.y - node_b->area.y;
+}
+
+static void
+glade_util_node_index_sort (gpointer key, GladeUtilNodeIndex *index, gpointer data)
+{
+	g_array_sort (index->nodes, glade_util_node_compare);
+}
+
+static void
+glade_util_invalidate_selection_nodes (void)
+{
+	GList *list;
+
+	for (list = glade_util_node_layouts; list; list = list->next)
+	{
+		g_signal_handlers_disconnect_by_func
+			(list->data, G_CALLBACK (glade_util_selection_size_allocate), NULL);
+		g_signal_handlers_disconnect_by_func
+			(list->data, G_CALLBACK (glade_util_selection_layout_destroy), NULL);
+	}
+	glade_util_node_layouts = 
+		(g_list_free (glade_util_node_layouts), NULL);
+
+	if (glade_util_node_cache)
+	{
+		g_hash_table_destroy (glade_util_node_cache);
+		glade_util_node_cache = NULL;
+	}
+	glade_util_node_volatile = 
+		(g_list_free (glade_util_node_volatile), NULL);
+}
+
+static void
+glade_util_selection_size_allocate (GtkWidget     *widget,
+				    GtkAllocation *allocation,
+				    gpointer       data)
+{
+	glade_util_invalidate_selection_nodes ();
+}
+
+static void
+glade_util_selection_layout_destroy (GtkObject *object,
+				     gpointer   data)
+{
+	glade_util_invalidate_selection_nodes ();
+}
+
+/* Only viewports of the project count, not the one showing the design */
+static gboolean
+glade_util_widget_in_viewport (GtkWidget *widget)
+{
+	for (widget = widget->parent; widget; widget = widget->parent)
+	{
+		if (GLADE_IS_DESIGN_LAYOUT (widget))
+			return FALSE;
+		if (GTK_IS_VIEWPORT (widget))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+static GtkWidget *
+glade_util_widget_get_layout (GtkWidget *widget)
+{
+	for (; widget; widget = widget->parent)
+		if (GLADE_IS_DESIGN_LAYOUT (widget))
+			return widget;
+	return NULL;
+}
+
+/* Calculates the offset of @window within the anchor window of the
+ * selection nodes of @widget's hierarchy, and returns the anchor.
+ */
+static GdkWindow *
+glade_util_calculate_anchor_offset (GtkWidget  *widget,
+				    GdkWindow  *window,
+				    gint       *x,
+				    gint       *y)
+{
+	GtkWidget *layout;
+	GdkWindow *anchor = NULL;
+	gint       tmp_x, tmp_y;
+
+	if ((layout = glade_util_widget_get_layout (widget)) != NULL)
+		anchor = layout->window;
+
+	*x = 0;
+	*y = 0;
+
+	while (window != anchor &&
+	       gdk_window_get_window_type (window) == GDK_WINDOW_CHILD)
+	{
+		gdk_window_get_position (window, &tmp_x, &tmp_y);
+		*x += tmp_x;
+		*y += tmp_y;
+		window = gdk_window_get_parent (window);
+	}
+
+	return window;
+}
+
+static void
+glade_util_build_selection_nodes (void)
+{
+	GladeUtilNodeIndex *index;
+	GladeUtilNode       node;
+	GdkWindow          *sel_win, *anchor;
+	GtkWidget          *layout;
+	GList              *list;
+	gint                x, y;
+	guint               n_cached = 0;
+
+	glade_util_node_cache = 
+		g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+				       (GDestroyNotify)glade_util_node_index_free);
+
+	for (list = glade_util_selection; list; list = list->next)
+	{
+		node.widget = list->data;
+
+		if ((sel_win = glade_util_get_window_positioned_in (node.widget)) == NULL)
+			continue;
+
+		if (glade_util_widget_in_viewport (node.widget))
+		{
+			glade_util_node_volatile = 
+				g_list_prepend (glade_util_node_volatile, node.widget);
+			continue;
+		}
+
+		anchor = glade_util_calculate_anchor_offset (node.widget, sel_win, &x, &y);
+
+		/* Relayouts below the layout move the node without
+		 * necessarily reallocating it */
+		if ((layout = glade_util_widget_get_layout (node.widget)) != NULL &&
+		    g_list_find (glade_util_node_layouts, layout) == NULL)
+		{
+			g_signal_connect (layout, "size-allocate",
+					  G_CALLBACK (glade_util_selection_size_allocate), NULL);
+			g_signal_connect (layout, "destroy",
+					  G_CALLBACK (glade_util_selection_layout_destroy), NULL);
+			glade_util_node_layouts = 
+				g_list_prepend (glade_util_node_layouts, layout);
+		}
+
+		node.area.x      = x + node.widget->allocation.x;
+		node.area.y      = y + node.widget->allocation.y;
+		node.area.width  = node.widget->allocation.width;
+		node.area.height = node.widget->allocation.height;
+
+		if ((index = g_hash_table_lookup (glade_util_node_cache, anchor)) == NULL)
+		{
+			index = g_new0 (GladeUtilNodeIndex, 1);
+			index->nodes = g_array_new (FALSE, FALSE, sizeof (GladeUtilNode));
+			g_hash_table_insert (glade_util_node_cache, anchor, index);
+		}
+
+		g_array_append_val (index->nodes, node);
+		index->max_height = MAX (index->max_height, node.area.height);
+		n_cached++;
+	}
+
+	g_hash_table_foreach (glade_util_node_cache, 
+			      (GHFunc)glade_util_node_index_sort, NULL);
+
+	GLADE_NOTE (LAYOUT, 
+		    g_message ("Selection nodes: %u cached, %u resolved on every expose",
+			       n_cached, g_list_length (glade_util_node_volatile)));
+}
+
+/* Draws the nodes of a selected widget positioned at @x, @y in
+ * @expose_win coordinates, if it intersects @area.
+ */
+static void
+glade_util_draw_nodes_in_area (GdkWindow    *expose_win,
+			       GdkGC        *gc,
+			       GdkRectangle *area,
+			       gint x, gint y,
+			       gint w, gint h)
+{
+	if (x < area->x + area->width  && x + w >= area->x &&
+	    y < area->y + area->height && y + h >= area->y)
+		glade_util_draw_nodes (expose_win, gc, x, y, w, h);
+}
+
 /**
  * glade_util_draw_selection_nodes:
  * @expose_win: a #GdkWindow
@@ -754,12 +1004,34 @@ glade_util_can_draw_nodes (GtkWidget *sel_widget, GdkWindow *sel_win,
 void
 glade_util_draw_selection_nodes (GdkWindow *expose_win)
 {
-	GtkWidget *expose_widget;
-	gint expose_win_x, expose_win_y;
-	gint expose_win_w, expose_win_h;
-	GdkWindow   *expose_toplevel;
-	GdkGC *gc;
-	GList *elem;
+	glade_util_draw_selection_nodes_in_area (expose_win, NULL);
+}
+
+/**
+ * glade_util_draw_selection_nodes_in_area:
+ * @expose_win: a #GdkWindow
+ * @area: the damaged area of @expose_win, or %NULL for the whole window
+ *
+ * Like glade_util_draw_selection_nodes() but only considers selection
+ * nodes that intersect @area, looked up in the cached geometry of the
+ * toplevel @expose_win belongs to.
+ *
+ */
+void
+glade_util_draw_selection_nodes_in_area (GdkWindow    *expose_win,
+					 GdkRectangle *area)
+{
+	GladeUtilNodeIndex *index;
+	GladeUtilNode      *node;
+	GtkWidget          *expose_widget;
+	GdkRectangle        expose_area;
+	gint                expose_win_x, expose_win_y;
+	GdkWindow          *expose_toplevel, *expose_anchor;
+	gint                expose_anchor_x, expose_anchor_y;
+	GdkGC              *gc;
+	GList              *elem;
+	guint               lo, hi, mid;
+	gint                top, bottom;
 
 	g_return_if_fail (GDK_IS_WINDOW (expose_win));
 
@@ -774,15 +1046,62 @@ glade_util_draw_selection_nodes (GdkWindow *expose_win)
 					    &expose_win_y,
 					    &expose_toplevel);
 
-	gdk_drawable_get_size (expose_win,
-			       &expose_win_w, &expose_win_h);
+	if (area)
+		expose_area = *area;
+	else
+	{
+		expose_area.x = expose_area.y = 0;
+		gdk_drawable_get_size (expose_win,
+				       &expose_area.width, &expose_area.height);
+	}
+
+	/* Calculate the offset of the expose window within the anchor
+	 * of the cached nodes. */
+	expose_anchor = glade_util_calculate_anchor_offset (expose_widget, expose_win,
+							    &expose_anchor_x,
+							    &expose_anchor_y);
+
+	if (glade_util_node_cache == NULL)
+		glade_util_build_selection_nodes ();
+
+	if ((index = g_hash_table_lookup (glade_util_node_cache, expose_anchor)) != NULL)
+	{
+		/* Damaged span in anchor coordinates */
+		top    = expose_anchor_y + expose_area.y;
+		bottom = top + expose_area.height;
+
+		/* Binary search the first node that may reach down into
+		 * the damaged span. */
+		for (lo = 0, hi = index->nodes->len; lo < hi; )
+		{
+			mid  = (lo + hi) / 2;
+			node = &g_array_index (index->nodes, GladeUtilNode, mid);
+			if (node->area.y + index->max_height < top)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		for (; lo < index->nodes->len; lo++)
+		{
+			node = &g_array_index (index->nodes, GladeUtilNode, lo);
+			if (node->area.y >= bottom)
+				break;
+
+			glade_util_draw_nodes_in_area (expose_win, gc, &expose_area,
+						       node->area.x - expose_anchor_x,
+						       node->area.y - expose_anchor_y,
+						       node->area.width,
+						       node->area.height);
+		}
+	}
 
-	/* Step through all the selected widgets. */
-	for (elem = glade_util_selection; elem; elem = elem->next) {
+	/* Widgets inside viewports are resolved on every expose */
+	for (elem = glade_util_node_volatile; elem; elem = elem->next) {
 
 		GtkWidget *sel_widget;
 		GdkWindow *sel_win, *sel_toplevel;
-		gint sel_x, sel_y, x, y, w, h;
+		gint sel_x, sel_y;
 
 		sel_widget = elem->data;
 		
@@ -798,20 +1117,13 @@ glade_util_draw_selection_nodes (GdkWindow *expose_win)
 		   event is in the same toplevel as the selected widget. */
 		if (expose_toplevel == sel_toplevel
 		    && glade_util_can_draw_nodes (sel_widget, sel_win,
-						  expose_win)) {
-			x = sel_x + sel_widget->allocation.x - expose_win_x;
-			y = sel_y + sel_widget->allocation.y - expose_win_y;
-			w = sel_widget->allocation.width;
-			h = sel_widget->allocation.height;
-
-			/* Draw the selection nodes if they intersect the
-			   expose window bounds. */
-			if (x < expose_win_w && x + w >= 0
-			    && y < expose_win_h && y + h >= 0) {
-				glade_util_draw_nodes (expose_win, gc,
-						       x, y, w, h);
-			}
-		}
+						  expose_win))
+			glade_util_draw_nodes_in_area 
+				(expose_win, gc, &expose_area,
+				 sel_x + sel_widget->allocation.x - expose_win_x,
+				 sel_y + sel_widget->allocation.y - expose_win_y,
+				 sel_widget->allocation.width,
+				 sel_widget->allocation.height);
 	}
 }
 
@@ -830,6 +1142,10 @@ glade_util_add_selection (GtkWidget *widget)
 
 	glade_util_selection = 
 		g_list_prepend (glade_util_selection, widget);
+	g_signal_connect (G_OBJECT (widget), "size-allocate",
+			  G_CALLBACK (glade_util_selection_size_allocate), NULL);
+	glade_util_invalidate_selection_nodes ();
+
 	gtk_widget_queue_draw (widget);
 }
 
@@ -848,6 +1164,9 @@ glade_util_remove_selection (GtkWidget *widget)
 
 	glade_util_selection = 
 		g_list_remove (glade_util_selection, widget);
+	g_signal_handlers_disconnect_by_func
+		(G_OBJECT (widget), G_CALLBACK (glade_util_selection_size_allocate), NULL);
+	glade_util_invalidate_selection_nodes ();
 
 	/* We redraw the parent, since the selection rectangle may not be
 	   cleared if we just redraw the widget itself. */
@@ -871,11 +1190,14 @@ glade_util_clear_selection (void)
 	     list = list->next)
 	{
 		widget = list->data;
+		g_signal_handlers_disconnect_by_func
+			(G_OBJECT (widget), G_CALLBACK (glade_util_selection_size_allocate), NULL);
 		gtk_widget_queue_draw (widget->parent ?
 				       widget->parent : widget);
 	}
 	glade_util_selection =
 		(g_list_free (glade_util_selection), NULL);
+	glade_util_invalidate_selection_nodes ();
 }
 
 /**
@@ -1063,6 +1385,34 @@ glade_util_basenames_match  (const gchar  *path1,
 	return match;
 }
 
+/* Returns a set of the data pointers in @list */
+static GHashTable *
+glade_util_list_to_set (GList *list)
+{
+	GHashTable *set = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+	for (; list; list = list->next)
+		g_hash_table_insert (set, list->data, list->data);
+
+	return set;
+}
+
+/* Returns a newly allocated list of the elements in @list that
+ * are not in @set, in the order of @list */
+static GList *
+glade_util_list_minus_set (GList      *list,
+			   GHashTable *set)
+{
+	GList *diff = NULL;
+
+	for (; list; list = list->next)
+	{
+		if (!g_hash_table_lookup_extended (set, list->data, NULL, NULL))
+			diff = g_list_prepend (diff, list->data);
+	}
+	return g_list_reverse (diff);
+}
+
 /**
  * glade_util_purify_list:
  * @list: A #GList
@@ -1073,12 +1423,19 @@ glade_util_basenames_match  (const gchar  *path1,
 GList *
 glade_util_purify_list (GList *list)
 {
-	GList *l, *newlist = NULL;
+	GHashTable *seen;
+	GList      *l, *newlist = NULL;
+
+	seen = g_hash_table_new (g_direct_hash, g_direct_equal);
 
 	for (l = list; l; l = l->next)
-		if (!g_list_find (newlist, l->data))
+		if (!g_hash_table_lookup_extended (seen, l->data, NULL, NULL))
+		{
+			g_hash_table_insert (seen, l->data, l->data);
 			newlist = g_list_prepend (newlist, l->data);
+		}
 
+	g_hash_table_destroy (seen);
 	g_list_free (list);
 
 	return g_list_reverse (newlist);
@@ -1097,15 +1454,14 @@ GList *
 glade_util_added_in_list (GList *old_list,
 			  GList *new_list)
 {
-	GList *added = NULL, *list;
+	GHashTable *old_set;
+	GList      *added;
 
-	for (list = new_list; list; list = list->next)
-	{
-		if (!g_list_find (old_list, list->data))
-			added = g_list_prepend (added, list->data);
-	} 
+	old_set = glade_util_list_to_set (old_list);
+	added   = glade_util_list_minus_set (new_list, old_set);
+	g_hash_table_destroy (old_set);
 
-	return g_list_reverse (added);
+	return added;
 }
 
 /**
@@ -1121,15 +1477,46 @@ GList *
 glade_util_removed_from_list (GList *old_list,
 			      GList *new_list)
 {
-	GList *added = NULL, *list;
+	GHashTable *new_set;
+	GList      *removed;
 
-	for (list = old_list; list; list = list->next)
-	{
-		if (!g_list_find (new_list, list->data))
-			added = g_list_prepend (added, list->data);
-	} 
+	new_set = glade_util_list_to_set (new_list);
+	removed = glade_util_list_minus_set (old_list, new_set);
+	g_hash_table_destroy (new_set);
 
-	return g_list_reverse (added);
+	return removed;
+}
+
+/**
+ * glade_util_diff_lists:
+ * @old_list: the old #GList
+ * @new_list: the new #GList
+ * @added: return location for the elements in @new_list but not in @old_list
+ * @removed: return location for the elements in @old_list no longer in @new_list
+ *
+ * Computes both glade_util_added_in_list() and glade_util_removed_from_list()
+ * in linear time; the returned lists keep the order of the lists they
+ * were taken from and should be freed with g_list_free().
+ */
+void
+glade_util_diff_lists (GList  *old_list,
+		       GList  *new_list,
+		       GList **added,
+		       GList **removed)
+{
+	GHashTable *old_set, *new_set;
+
+	g_return_if_fail (added != NULL);
+	g_return_if_fail (removed != NULL);
+
+	old_set = glade_util_list_to_set (old_list);
+	new_set = glade_util_list_to_set (new_list);
+
+	*added   = glade_util_list_minus_set (new_list, old_set);
+	*removed = glade_util_list_minus_set (old_list, new_set);
+
+	g_hash_table_destroy (old_set);
+	g_hash_table_destroy (new_set);
 }
 
 
@@ -1201,6 +1588,221 @@ glade_util_canonical_match (const gchar  *src_path,
 	return match;
 }
 
+/* Checks whether @dest_path is already a copy of @src_path,
+ * files with a different size or modification time are not
+ * compared any further.
+ */
+static gboolean
+glade_util_file_is_copy (const gchar *src_path,
+			 const gchar *dest_path)
+{
+	struct stat  src_stat, dest_stat;
+	FILE        *src, *dest;
+	gchar       *src_buffer, *dest_buffer;
+	gsize        src_read, dest_read;
+	gboolean     same = FALSE;
+
+	if (g_stat (src_path, &src_stat) != 0 ||
+	    g_stat (dest_path, &dest_stat) != 0 ||
+	    src_stat.st_size  != dest_stat.st_size ||
+	    src_stat.st_mtime != dest_stat.st_mtime)
+		return FALSE;
+
+	if ((src = g_fopen (src_path, "rb")) == NULL)
+		return FALSE;
+	if ((dest = g_fopen (dest_path, "rb")) == NULL)
+	{
+		fclose (src);
+		return FALSE;
+	}
+
+	src_buffer  = g_malloc (GLADE_UTIL_COPY_BUFFSIZE);
+	dest_buffer = g_malloc (GLADE_UTIL_COPY_BUFFSIZE);
+
+	do 
+	{
+		src_read  = fread (src_buffer, 1, GLADE_UTIL_COPY_BUFFSIZE, src);
+		dest_read = fread (dest_buffer, 1, GLADE_UTIL_COPY_BUFFSIZE, dest);
+
+		if (src_read != dest_read ||
+		    memcmp (src_buffer, dest_buffer, src_read) != 0)
+			break;
+
+		same = feof (src) && feof (dest);
+	}
+	while (src_read > 0 && !same);
+
+	same = same && !ferror (src) && !ferror (dest);
+
+	g_free (src_buffer);
+	g_free (dest_buffer);
+	fclose (src);
+	fclose (dest);
+
+	return same;
+}
+
+#ifdef G_OS_UNIX
+static gboolean
+glade_util_copy_fd (gint          src_fd,
+		    gint          dest_fd,
+		    off_t         size,
+		    GError      **error)
+{
+	gchar   *buffer;
+	gssize   bytes_read, bytes_written, written;
+
+#ifdef FICLONE
+	/* Share the extents on filesystems that support it */
+	if (ioctl (dest_fd, FICLONE, src_fd) == 0)
+		return TRUE;
+#endif
+
+#ifdef HAVE_COPY_FILE_RANGE
+	{
+		off_t   copied = 0;
+		gssize  ret = 0;
+
+		while (copied < size &&
+		       (ret = copy_file_range (src_fd, NULL, dest_fd, NULL, 
+					       size - copied, 0)) > 0)
+			copied += ret;
+
+		if (ret >= 0)
+			return TRUE;
+
+		/* Not supported across these files, fall back to plain
+		 * reads and writes unless part of the file is written.
+		 */
+		if (copied > 0 || 
+		    (errno != EXDEV && errno != ENOSYS && 
+		     errno != EINVAL && errno != EOPNOTSUPP))
+		{
+			g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+				     "%s", g_strerror (errno));
+			return FALSE;
+		}
+	}
+#endif
+
+	buffer = g_malloc (GLADE_UTIL_COPY_BUFFSIZE);
+
+	while ((bytes_read = read (src_fd, buffer, GLADE_UTIL_COPY_BUFFSIZE)) != 0)
+	{
+		if (bytes_read < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		for (bytes_written = 0; bytes_written < bytes_read; bytes_written += written)
+		{
+			if ((written = write (dest_fd, buffer + bytes_written, 
+					      bytes_read - bytes_written)) < 0)
+			{
+				if (errno == EINTR)
+				{
+					written = 0;
+					continue;
+				}
+				break;
+			}
+		}
+
+		if (bytes_written < bytes_read)
+		{
+			bytes_read = -1;
+			break;
+		}
+	}
+	g_free (buffer);
+
+	if (bytes_read < 0)
+	{
+		g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+			     "%s", g_strerror (errno));
+		return FALSE;
+	}
+	return TRUE;
+}
+#endif
+
+/* Copies @src_path to @dest_path without any user interaction, this
+ * is safe to call from a thread. The modification time is preserved
+ * so that glade_util_file_is_copy() recognizes the copy later on.
+ */
+static gboolean
+glade_util_copy_file_real (const gchar  *src_path,
+			   const gchar  *dest_path,
+			   GError      **error)
+{
+#ifdef G_OS_UNIX
+	struct stat     src_stat;
+	struct utimbuf  times;
+	gint            src_fd, dest_fd;
+	gboolean        success;
+
+	if ((src_fd = g_open (src_path, O_RDONLY, 0)) < 0 ||
+	    fstat (src_fd, &src_stat) != 0)
+	{
+		g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+			     _("Failed to open %s for reading: %s"), 
+			     src_path, g_strerror (errno));
+		if (src_fd >= 0)
+			close (src_fd);
+		return FALSE;
+	}
+
+	if ((dest_fd = g_open (dest_path, O_WRONLY | O_CREAT | O_TRUNC, 
+			       src_stat.st_mode & 0777)) < 0)
+	{
+		g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+			     _("Failed to open %s for writing: %s"), 
+			     dest_path, g_strerror (errno));
+		close (src_fd);
+		return FALSE;
+	}
+
+	success = glade_util_copy_fd (src_fd, dest_fd, src_stat.st_size, error);
+
+	if (close (dest_fd) != 0 && success)
+	{
+		g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errno),
+			     "%s", g_strerror (errno));
+		success = FALSE;
+	}
+	close (src_fd);
+
+	if (success)
+	{
+		times.actime  = src_stat.st_atime;
+		times.modtime = src_stat.st_mtime;
+		utime (dest_path, &times);
+	}
+	else if (error && *error)
+	{
+		gchar *message = (*error)->message;
+
+		(*error)->message = g_strdup_printf (_("Error copying %s to %s: %s"),
+						     src_path, dest_path, message);
+		g_free (message);
+	}
+	return success;
+#else
+	gchar    *contents;
+	gsize     length;
+	gboolean  success = FALSE;
+
+	if (g_file_get_contents (src_path, &contents, &length, error))
+	{
+		success = g_file_set_contents (dest_path, contents, length, error);
+		g_free (contents);
+	}
+	return success;
+#endif
+}
+
 /**
  * glade_util_copy_file:
  * @src_path:  the path to the source file
@@ -1216,12 +1818,7 @@ gboolean
 glade_util_copy_file (const gchar  *src_path,
 		      const gchar  *dest_path)
 {
-	GIOChannel *src, *dest;
-	GError     *error = NULL;
-	GIOStatus   read_status, write_status = G_IO_STATUS_ERROR;
-	gchar       buffer[GLADE_UTIL_COPY_BUFFSIZE];
-	gsize       bytes_read, bytes_written, written;
-	gboolean    success = FALSE;
+	GError *error = NULL;
 
 	/* FIXME: This may break if src_path & dest_path are actually 
 	 * the same file, right now the canonical comparison is the
@@ -1231,100 +1828,143 @@ glade_util_copy_file (const gchar  *src_path,
 		return FALSE;
 
 	if (g_file_test (dest_path, G_FILE_TEST_IS_REGULAR) != FALSE)
+	{
+		/* Nothing to do */
+		if (glade_util_file_is_copy (src_path, dest_path))
+			return TRUE;
+
 		if (glade_util_ui_message
 		    (glade_app_get_window(), GLADE_UI_YES_OR_NO,
 		     _("%s exists.\nDo you want to replace it?"), dest_path) == FALSE)
 		    return FALSE;
+	}
 
+	if (glade_util_copy_file_real (src_path, dest_path, &error) == FALSE)
+	{
+		glade_util_ui_message (glade_app_get_window(),
+				       GLADE_UI_ERROR, "%s", error->message);
+		g_error_free (error);
+		return FALSE;
+	}
+	return TRUE;
+}
 
-	if ((src = g_io_channel_new_file (src_path, "r", &error)) != NULL)
+typedef struct {
+	const gchar *src_path;
+	const gchar *dest_path;
+	gboolean     conflict;
+	GError      *error;
+} GladeUtilCopy;
+
+static void
+glade_util_copy_thread (GladeUtilCopy *copy,
+			gpointer       data)
+{
+	glade_util_copy_file_real (copy->src_path, copy->dest_path, &copy->error);
+}
+
+/**
+ * glade_util_copy_files:
+ * @src_paths:  a #GList of paths to source files
+ * @dest_paths: a #GList of destination paths, one for each of @src_paths
+ *
+ * Copies a set of files, destinations which are already copies
+ * of their source are skipped and the user is asked only once
+ * about overwriting the other existing destinations. The files
+ * are copied in parallel where threads are available; any failures 
+ * are reported in a single error message.
+ *
+ * Returns: True if all the required copies were successfull.
+ */
+gboolean
+glade_util_copy_files (GList *src_paths,
+		       GList *dest_paths)
+{
+	GladeUtilCopy *copies, *copy;
+	GThreadPool   *pool = NULL;
+	GString       *conflicts = NULL, *errors = NULL;
+	GList         *src, *dest;
+	gint           n_copies = 0, i;
+	gboolean       replace = TRUE;
+
+	copies = g_new0 (GladeUtilCopy, g_list_length (src_paths));
+
+	for (src = src_paths, dest = dest_paths; 
+	     src && dest; src = src->next, dest = dest->next)
 	{
-		g_io_channel_set_encoding (src, NULL, NULL);
+		if (glade_util_canonical_match (src->data, dest->data))
+			continue;
 
-		if ((dest = g_io_channel_new_file (dest_path, "w", &error)) != NULL)
+		if (g_file_test (dest->data, G_FILE_TEST_IS_REGULAR))
 		{
-			g_io_channel_set_encoding (dest, NULL, NULL);
+			if (glade_util_file_is_copy (src->data, dest->data))
+				continue;
 
-			while ((read_status = g_io_channel_read_chars 
-				(src, buffer, GLADE_UTIL_COPY_BUFFSIZE,
-				 &bytes_read, &error)) != G_IO_STATUS_ERROR)
-			{
-				bytes_written = 0;
-				while ((write_status = g_io_channel_write_chars 
-					(dest, buffer + bytes_written, 
-					 bytes_read - bytes_written, 
-					 &written, &error)) != G_IO_STATUS_ERROR &&
-				       (bytes_written + written) < bytes_read)
-					bytes_written += written;
-				
-				if (write_status == G_IO_STATUS_ERROR)
-				{
-					glade_util_ui_message (glade_app_get_window(),
-							       GLADE_UI_ERROR,
-							       _("Error writing to %s: %s"),
-							       dest_path, error->message);
-					error = (g_error_free (error), NULL);
-					break;
-				}
+			if (conflicts == NULL)
+				conflicts = g_string_new (NULL);
+			g_string_append_printf (conflicts, "\n%s", (gchar *)dest->data);
 
-				/* Break on EOF & ERROR but not AGAIN and not NORMAL */
-				if (read_status == G_IO_STATUS_EOF) break;
-			}
-			
-			if (read_status == G_IO_STATUS_ERROR)
-			{
-				glade_util_ui_message (glade_app_get_window(),
-						       GLADE_UI_ERROR,
-						       _("Error reading %s: %s"),
-						       src_path, error->message);
-				error = (g_error_free (error), NULL);
-			}
+			copies[n_copies].conflict = TRUE;
+		}
 
+		copies[n_copies].src_path  = src->data;
+		copies[n_copies].dest_path = dest->data;
+		n_copies++;
+	}
 
-			/* From here on, unless we have problems shutting down, succuss ! */
-			success = (read_status == G_IO_STATUS_EOF && 
-				   write_status == G_IO_STATUS_NORMAL);
+	if (conflicts)
+	{
+		replace = glade_util_ui_message
+			(glade_app_get_window(), GLADE_UI_YES_OR_NO,
+			 _("The following files already exist:%s\n"
+			   "Do you want to replace them?"), conflicts->str);
+		g_string_free (conflicts, TRUE);
+	}
 
-			if (g_io_channel_shutdown (dest, TRUE, &error) != G_IO_STATUS_NORMAL)
-			{
-				glade_util_ui_message
-					(glade_app_get_window(),
-					 GLADE_UI_ERROR,
-					 _("Error shutting down I/O channel %s: %s"),
-						       dest_path, error->message);
-				error = (g_error_free (error), NULL);
-				success = FALSE;
-			}
-		}
+	if (g_thread_supported () && n_copies > 1)
+		pool = g_thread_pool_new ((GFunc)glade_util_copy_thread, NULL,
+					  MIN (n_copies, GLADE_UTIL_COPY_THREADS),
+					  FALSE, NULL);
+
+	for (i = 0; i < n_copies; i++)
+	{
+		copy = &copies[i];
+
+		if (copy->conflict && replace == FALSE)
+			continue;
+
+		if (pool)
+			g_thread_pool_push (pool, copy, NULL);
 		else
-		{
-			glade_util_ui_message (glade_app_get_window(),
-					       GLADE_UI_ERROR,
-					       _("Failed to open %s for writing: %s"), 
-					       dest_path, error->message);
-			error = (g_error_free (error), NULL);
+			glade_util_copy_thread (copy, NULL);
+	}
 
-		}
+	/* Wait for all the copies to finish */
+	if (pool)
+		g_thread_pool_free (pool, FALSE, TRUE);
 
+	for (i = 0; i < n_copies; i++)
+	{
+		if (copies[i].error == NULL)
+			continue;
 
-		if (g_io_channel_shutdown (src, TRUE, &error) != G_IO_STATUS_NORMAL)
-		{
-			glade_util_ui_message (glade_app_get_window(),
-					       GLADE_UI_ERROR,
-					       _("Error shutting down io channel %s: %s"),
-					       src_path, error->message);
-			success = FALSE;
-		}
+		if (errors == NULL)
+			errors = g_string_new (NULL);
+		else
+			g_string_append_c (errors, '\n');
+		g_string_append (errors, copies[i].error->message);
+		g_error_free (copies[i].error);
 	}
-	else 
+	g_free (copies);
+
+	if (errors)
 	{
 		glade_util_ui_message (glade_app_get_window(),
-				       GLADE_UI_ERROR,
-				       _("Failed to open %s for reading: %s"), 
-				       src_path, error->message);
-		error = (g_error_free (error), NULL);
+				       GLADE_UI_ERROR, "%s", errors->str);
+		g_string_free (errors, TRUE);
+		return FALSE;
 	}
-	return success;
+	return TRUE;
 }
 
 /**
@@ -71,6 +71,9 @@ GList            *glade_util_get_selection    (void);
 
 void              glade_util_draw_selection_nodes (GdkWindow *expose_win);
 
+void              glade_util_draw_selection_nodes_in_area (GdkWindow    *expose_win,
+							   GdkRectangle *area);
+
 GList            *glade_util_container_get_all_children (GtkContainer *container);
 
 gint              glade_util_count_placeholders    (GladeWidget *parent);
@@ -90,12 +93,20 @@ GList            *glade_util_added_in_list         (GList        *old_list,
 GList            *glade_util_removed_from_list     (GList        *old_list,
 						    GList        *new_list);
 
+void              glade_util_diff_lists            (GList        *old_list,
+						    GList        *new_list,
+						    GList       **added,
+						    GList       **removed);
+
 gchar            *glade_util_canonical_path        (const gchar  *path);
 
 
 gboolean          glade_util_copy_file             (const gchar  *src_path,
 						    const gchar  *dest_path);
 
+gboolean          glade_util_copy_files            (GList        *src_paths,
+						    GList        *dest_paths);
+
 gboolean          glade_util_class_implements_interface (GType class_type, 
 							 GType iface_type);
 
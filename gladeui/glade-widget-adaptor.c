@@ -2468,6 +2468,21 @@ glade_widget_adaptor_get_packing_default (GladeWidgetAdaptor *child_adaptor,
 	return NULL;
 }
 
+/**
+ * glade_widget_adaptor_get_catalog:
+ * @adaptor: A #GladeWidgetAdaptor
+ *
+ * Returns: the name of the catalog which declared @adaptor, the
+ *          string belongs to @adaptor and should not be freed
+ */
+G_CONST_RETURN gchar *
+glade_widget_adaptor_get_catalog (GladeWidgetAdaptor *adaptor)
+{
+	g_return_val_if_fail (GLADE_IS_WIDGET_ADAPTOR (adaptor), NULL);
+
+	return adaptor->priv->catalog;
+}
+
 /**
  * glade_widget_adaptor_is_container:
  * @adaptor: A #GladeWidgetAdaptor
@@ -594,6 +594,9 @@ gchar               *glade_widget_adaptor_get_packing_default(GladeWidgetAdaptor
 
 gboolean             glade_widget_adaptor_is_container       (GladeWidgetAdaptor *adaptor);
 
+G_CONST_RETURN
+gchar               *glade_widget_adaptor_get_catalog        (GladeWidgetAdaptor *adaptor);
+
 gboolean             glade_widget_adaptor_action_add         (GladeWidgetAdaptor *adaptor,
 							      const gchar *action_path,
 							      const gchar *label,
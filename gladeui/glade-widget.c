@@ -55,6 +55,7 @@
 #include "glade-app.h"
 #include "glade-design-view.h"
 #include "glade-widget-action.h"
+#include "glade-debug.h"
 
 
 
@@ -75,6 +76,7 @@ static GladeWidget *glade_widget_new_from_widget_info  (GladeWidgetInfo       *i
 
 static gboolean     glade_window_is_embedded           (GtkWindow *window);
 static gboolean     glade_widget_embed                 (GladeWidget *widget);
+static void         free_signals                       (gpointer value);
 
 enum
 {
@@ -113,10 +115,46 @@ static guint         glade_widget_signals[LAST_SIGNAL] = {0};
  */
 static GladeProject *loading_project = NULL;
 static GQuark        glade_widget_name_quark = 0;
+static GQuark        glade_widget_prop_refs_quark = 0;
 
 
 G_DEFINE_TYPE (GladeWidget, glade_widget, G_TYPE_OBJECT)
 
+/* Lets the project serialize @widget's toplevel again on the next save */
+static void
+glade_widget_changed (GladeWidget *widget)
+{
+	if (widget->project)
+		glade_project_widget_changed (widget->project, widget);
+}
+
+/* Properties referring to a widget are written with its name */
+static void
+glade_widget_prop_ref_changed (GladeProperty *property,
+			       gpointer       user_data)
+{
+	if (property->widget)
+		glade_widget_changed (property->widget);
+}
+
+/* Maps the properties in widget->prop_refs to their links, kept out of
+ * the public structure so that the list stays what plugins expect.
+ */
+static GHashTable *
+glade_widget_get_prop_ref_index (GladeWidget *widget)
+{
+	GHashTable *index;
+
+	if ((index = g_object_get_qdata (G_OBJECT (widget), 
+					 glade_widget_prop_refs_quark)) == NULL)
+	{
+		index = g_hash_table_new (g_direct_hash, g_direct_equal);
+		g_object_set_qdata_full (G_OBJECT (widget), glade_widget_prop_refs_quark,
+					 index, (GDestroyNotify)g_hash_table_destroy);
+	}
+	return index;
+}
+
 /*******************************************************************************
                            GladeWidget class methods
  *******************************************************************************/
@@ -753,7 +791,15 @@ glade_widget_constructor (GType                  type,
 	if (GTK_IS_WIDGET (gwidget->object) && !GTK_WIDGET_TOPLEVEL (gwidget->object))
 	{
 		gwidget->visible = TRUE;
-		gtk_widget_show_all (GTK_WIDGET (gwidget->object));
+
+		/* While reading a file every widget shows itself as it is built,
+		 * internal children are shown along with their toplevel by
+		 * glade_widget_show() if it is ever shown at all.
+		 */
+		if (loading_project)
+			gtk_widget_show (GTK_WIDGET (gwidget->object));
+		else
+			gtk_widget_show_all (GTK_WIDGET (gwidget->object));
 	}
 	else if (GTK_IS_WIDGET (gwidget->object) == FALSE)
 		gwidget->visible = TRUE;
@@ -771,6 +817,7 @@ glade_widget_finalize (GObject *object)
 	g_free (widget->name);
 	g_free (widget->internal);
 	g_hash_table_destroy (widget->signals);
+	g_list_free (widget->prop_refs);
 
 	G_OBJECT_CLASS(glade_widget_parent_class)->finalize(object);
 }
@@ -978,6 +1025,9 @@ glade_widget_class_init (GladeWidgetClass *klass)
 	if (glade_widget_name_quark == 0)
 		glade_widget_name_quark = 
 			g_quark_from_static_string ("GladeWidgetDataTag");
+	if (glade_widget_prop_refs_quark == 0)
+		glade_widget_prop_refs_quark = 
+			g_quark_from_static_string ("glade-widget-prop-refs-index");
 
 	object_class = G_OBJECT_CLASS (klass);
 
@@ -1349,7 +1399,9 @@ glade_widget_dup_internal (GladeWidget *parent,
 	else
 	{
 		gchar *name = g_strdup (template_widget->name);
-fprintf(stderr,"template name[%s]\n",name);
+
+		GLADE_NOTE (COMMAND, g_message ("Duplicating template %s", name));
+
 		gwidget = glade_widget_adaptor_create_widget
 			(template_widget->adaptor, FALSE,
 			 "name", name,
@@ -1482,12 +1534,11 @@ glade_widget_extract_children (GladeWidget *gwidget)
 	{
 		GObject     *child   = G_OBJECT(list->data);
 		GladeWidget *gchild  = glade_widget_get_from_gobject (child);
-#if 0
-		g_print ("Extracting %s from %s\n",
-			 gchild ? gchild->name : 
-			 GLADE_IS_PLACEHOLDER (child) ? "placeholder" : "unknown widget", 
-			 gwidget->name);
-#endif
+		GLADE_NOTE (COMMAND,
+			    g_message ("Extracting %s from %s",
+				       gchild ? gchild->name : 
+				       GLADE_IS_PLACEHOLDER (child) ? "placeholder" : "unknown widget", 
+				       gwidget->name));
 		if (gchild && gchild->internal)
 		{
 			/* Recurse and collect any deep child hierarchies
@@ -1712,7 +1763,7 @@ expose_draw_selection (GtkWidget       *widget_gtk,
 		       GdkEventExpose  *event,
 		       GladeWidget     *gwidget)
 {
-	glade_util_draw_selection_nodes (event->window);
+	glade_util_draw_selection_nodes_in_area (event->window, &event->area);
         return FALSE;
 }
 
@@ -2189,6 +2240,14 @@ glade_widget_show (GladeWidget *widget)
 		}
 		else if (!layout)
 			return;
+
+		/* Already the embedded window, nothing to realize or lay out */
+		if (gtk_bin_get_child (GTK_BIN (layout)) == GTK_WIDGET (widget->object) &&
+		    GTK_WIDGET_VISIBLE (widget->object))
+		{
+			widget->visible = TRUE;
+			return;
+		}
 		
 		if (gtk_bin_get_child (GTK_BIN (layout)) != NULL)
 			gtk_container_remove (GTK_CONTAINER (layout), gtk_bin_get_child (GTK_BIN (layout)));
@@ -2235,12 +2294,21 @@ glade_widget_hide (GladeWidget *widget)
 void
 glade_widget_add_prop_ref (GladeWidget *widget, GladeProperty *property)
 {
+	GHashTable *index;
+
 	g_return_if_fail (GLADE_IS_WIDGET (widget));
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
 
-	if (property && !widget->prop_refs_readonly &&
-	    !g_list_find (widget->prop_refs, property))
-		widget->prop_refs = g_list_prepend (widget->prop_refs, property);
+	if (property && !widget->prop_refs_readonly)
+	{
+		index = glade_widget_get_prop_ref_index (widget);
+
+		if (g_hash_table_lookup (index, property) == NULL)
+		{
+			widget->prop_refs = g_list_prepend (widget->prop_refs, property);
+			g_hash_table_insert (index, property, widget->prop_refs);
+		}
+	}
 }
 
 /**
@@ -2256,11 +2324,22 @@ glade_widget_add_prop_ref (GladeWidget *widget, GladeProperty *property)
 void
 glade_widget_remove_prop_ref (GladeWidget *widget, GladeProperty *property)
 {
+	GHashTable *index;
+	GList      *link;
+
 	g_return_if_fail (GLADE_IS_WIDGET (widget));
 	g_return_if_fail (GLADE_IS_PROPERTY (property));
 
-	if (!widget->prop_refs_readonly)
-		widget->prop_refs = g_list_remove (widget->prop_refs, property);
+	if (!widget->prop_refs_readonly && widget->prop_refs)
+	{
+		index = glade_widget_get_prop_ref_index (widget);
+
+		if ((link = g_hash_table_lookup (index, property)) != NULL)
+		{
+			g_hash_table_remove (index, property);
+			widget->prop_refs = g_list_delete_link (widget->prop_refs, link);
+		}
+	}
 }
 
 /**
@@ -2387,6 +2466,8 @@ glade_widget_add_child (GladeWidget      *parent,
 	g_return_if_fail (GLADE_IS_WIDGET (child));
 
 	GLADE_WIDGET_GET_CLASS (parent)->add_child (parent, child, at_mouse);
+
+	glade_widget_changed (parent);
 }
 
 /**
@@ -2404,6 +2485,8 @@ glade_widget_remove_child (GladeWidget      *parent,
 	g_return_if_fail (GLADE_IS_WIDGET (child));
 
 	GLADE_WIDGET_GET_CLASS (parent)->remove_child (parent, child);
+
+	glade_widget_changed (parent);
 }
 
 /**
@@ -2550,6 +2633,8 @@ glade_widget_add_signal_handler	(GladeWidget *widget, GladeSignal *signal_handle
 	g_return_if_fail (GLADE_IS_WIDGET (widget));
 
 	g_signal_emit (widget, glade_widget_signals[ADD_SIGNAL_HANDLER], 0, signal_handler);
+
+	glade_widget_changed (widget);
 }
 
 
@@ -2566,6 +2651,8 @@ glade_widget_remove_signal_handler (GladeWidget *widget, GladeSignal *signal_han
 	g_return_if_fail (GLADE_IS_WIDGET (widget));
 
 	g_signal_emit (widget, glade_widget_signals[REMOVE_SIGNAL_HANDLER], 0, signal_handler);
+
+	glade_widget_changed (widget);
 }
 
 /**
@@ -2585,6 +2672,8 @@ glade_widget_change_signal_handler (GladeWidget *widget,
 
 	g_signal_emit (widget, glade_widget_signals[CHANGE_SIGNAL_HANDLER], 0,
 		       old_signal_handler, new_signal_handler);
+
+	glade_widget_changed (widget);
 }
 
 /**
@@ -2599,6 +2688,7 @@ glade_widget_list_signal_handlers (GladeWidget *widget,
 				   const gchar *signal_name) /* array of GladeSignal* */
 {
 	g_return_val_if_fail (GLADE_IS_WIDGET (widget), NULL);
+
 	return g_hash_table_lookup (widget->signals, signal_name);
 }
 
@@ -2626,6 +2716,14 @@ glade_widget_set_name (GladeWidget *widget, const gchar *name)
 			g_free (widget->name);
 		widget->name = g_strdup (name);
 		g_object_notify (G_OBJECT (widget), "name");
+
+		if (widget->project)
+			glade_project_widget_event (widget->project, widget, 
+						    GLADE_PROJECT_WIDGET_RENAMED);
+
+		glade_widget_changed (widget);
+		g_list_foreach (widget->prop_refs, 
+				(GFunc)glade_widget_prop_ref_changed, NULL);
 	}
 }
 
@@ -2657,6 +2755,8 @@ glade_widget_set_internal (GladeWidget *widget, const gchar *internal)
 		g_free (widget->internal);
 		widget->internal = g_strdup (internal);
 		g_object_notify (G_OBJECT (widget), "internal");
+
+		glade_widget_changed (widget);
 	}
 }
 
@@ -2696,10 +2796,17 @@ glade_widget_get_adaptor (GladeWidget *widget)
 void
 glade_widget_set_project (GladeWidget *widget, GladeProject *project)
 {
+	GladeProject *old_project = widget->project;
+
 	if (widget->project != project)
 	{
 		widget->project = project;
 		g_object_notify (G_OBJECT (widget), "project");
+
+		/* A widget is only in one project at a time */
+		if (old_project)
+			glade_project_widget_event (old_project, widget, 
+						    GLADE_PROJECT_WIDGET_MOVED);
 	}
 }
 
@@ -3487,9 +3594,14 @@ glade_widget_set_parent (GladeWidget *widget,
 
 	g_return_if_fail (GLADE_IS_WIDGET (widget));
 
+	/* Both the old and the new toplevel change here */
+	glade_widget_changed (widget);
+
 	old_parent     = widget->parent;
 	widget->parent = parent;
 
+	glade_widget_changed (widget);
+
 	/* Set packing props only if the object is actually parented by 'parent'
 	 * (a subsequent call should come from glade_command after parenting).
 	 */
@@ -3532,6 +3644,8 @@ glade_widget_set_packing_properties (GladeWidget *widget,
 	g_list_free (widget->packing_properties);
 	widget->packing_properties = NULL;
 
+	glade_widget_changed (widget);
+
 	/* We have to detect whether this is an anarchist child of a composite
 	 * widget or not, in otherwords; whether its really a direct child or
 	 * a child of a popup window created on the composite widget's behalf.
@@ -3614,6 +3728,8 @@ glade_widget_replace (GladeWidget *parent, GObject *old_object, GObject *new_obj
 	g_return_if_fail (G_IS_OBJECT (new_object));
 
 	GLADE_WIDGET_GET_CLASS (parent)->replace_child (parent, old_object, new_object);
+
+	glade_widget_changed (parent);
 }
 
 /* XML Serialization */
@@ -29,6 +29,7 @@
 
 #include <gladeui/glade-editor-property.h>
 #include <gladeui/glade-base-editor.h>
+#include <gladeui/glade-debug.h>
 
 
 #include <gtk/gtk.h>
@@ -665,13 +666,14 @@ glade_gtk_box_configure_child (GladeFixed   *fixed,
 			iter_span = bchild->widget->allocation.height;
 		}
 
-#if 0
-		gtk_container_child_get (GTK_CONTAINER (box),
-					 bchild->widget,
-					 "position", &position, NULL);
-		g_print ("widget: %p pos %d, point %d, trans_point %d, iter_span %d\n", 
-			 bchild->widget, position, point, trans_point, iter_span);
-#endif
+		GLADE_NOTE (PLUGIN,
+		{
+			gtk_container_child_get (GTK_CONTAINER (box),
+						 bchild->widget,
+						 "position", &position, NULL);
+			g_message ("widget: %p pos %d, point %d, trans_point %d, iter_span %d", 
+				   bchild->widget, position, point, trans_point, iter_span);
+		});
 
 		if (iter_span <= span)
 		{
@@ -693,11 +695,11 @@ glade_gtk_box_configure_child (GladeFixed   *fixed,
 						 bchild->widget,
 						 "position", &position, NULL);
 
-#if 0
-			g_print ("setting position of %s from %d to %d, "
-				 "(point %d iter_span %d)\n", 
-				 child->name, old_position, position, trans_point, iter_span);
-#endif
+			GLADE_NOTE (PLUGIN,
+				    g_message ("setting position of %s from %d to %d, "
+					       "(point %d iter_span %d)", 
+					       child->name, old_position, position, 
+					       trans_point, iter_span));
 
 			glade_widget_pack_property_set
 				(child, "position", position);
@@ -825,36 +827,97 @@ glade_gtk_box_post_create (GladeWidgetAdaptor *adaptor,
 
 }
 
-static gint
-sort_box_children (GtkWidget *widget_a, GtkWidget *widget_b)
+/* Rebuilds the child list of @box in the order given by @order (which
+ * holds every child widget of @box) in one go, and queues a single
+ * resize instead of one for every gtk_box_reorder_child() call.
+ */
+static void
+glade_gtk_box_reorder (GtkBox *box, GtkWidget **order)
 {
-	GtkWidget   *box;
-	GladeWidget *gwidget_a, *gwidget_b;
-	gint         position_a, position_b;
+	GHashTable  *bchildren;
+	GList       *list, *new_children = NULL, *moved = NULL;
+	GtkBoxChild *bchild;
+	gint         i;
 
-	gwidget_a = glade_widget_get_from_gobject (widget_a);
-	gwidget_b = glade_widget_get_from_gobject (widget_b);
+	bchildren = g_hash_table_new (g_direct_hash, g_direct_equal);
+	for (list = box->children; list; list = list->next)
+	{
+		bchild = list->data;
+		g_hash_table_insert (bchildren, bchild->widget, bchild);
+	}
 
-	box = gtk_widget_get_parent (widget_a);
+	for (list = box->children, i = 0; list; list = list->next, i++)
+	{
+		bchild = g_hash_table_lookup (bchildren, order[i]);
+		if (bchild != list->data)
+			moved = g_list_prepend (moved, bchild->widget);
+		new_children = g_list_prepend (new_children, bchild);
+	}
+	g_hash_table_destroy (bchildren);
 
-	if (gwidget_a)
-		glade_widget_pack_property_get
-			(gwidget_a, "position", &position_a);
-	else
-		gtk_container_child_get (GTK_CONTAINER (box),
-					 widget_a,
-					 "position", &position_a,
-					 NULL);
-
-	if (gwidget_b)
-		glade_widget_pack_property_get
-			(gwidget_b, "position", &position_b);
-	else
-		gtk_container_child_get (GTK_CONTAINER (box),
-					 widget_b,
-					 "position", &position_b,
-					 NULL);
-	return position_a - position_b;
+	if (moved == NULL)
+	{
+		g_list_free (new_children);
+		return;
+	}
+
+	g_list_free (box->children);
+	box->children = g_list_reverse (new_children);
+
+	for (list = moved; list; list = list->next)
+		gtk_widget_child_notify (GTK_WIDGET (list->data), "position");
+	g_list_free (moved);
+
+	if (GTK_WIDGET_VISIBLE (box))
+		gtk_widget_queue_resize (GTK_WIDGET (box));
+}
+
+/* Returns a newly allocated array with the children of @box ordered so
+ * that every GladeWidget lands on its "position" packing property, other
+ * children (and children whose position is taken or out of range) fill
+ * the remaining slots in their current order.
+ */
+static GtkWidget **
+glade_gtk_box_get_position_order (GtkBox      *box,
+				  GladeWidget *gchild,
+				  gint         child_position)
+{
+	GtkWidget   **order;
+	GladeWidget  *gwidget;
+	GtkWidget    *widget;
+	GList        *list, *rest = NULL;
+	gint          n, i, position;
+
+	n     = g_list_length (box->children);
+	order = g_new0 (GtkWidget *, n);
+
+	for (list = box->children; list; list = list->next)
+	{
+		widget  = ((GtkBoxChild *)list->data)->widget;
+		gwidget = glade_widget_get_from_gobject (widget);
+
+		if (gchild && gwidget == gchild)
+			position = child_position;
+		else if (gwidget == NULL ||
+			 !glade_widget_pack_property_get (gwidget, "position", &position))
+			position = -1;
+
+		if (position >= 0 && position < n && order[position] == NULL)
+			order[position] = widget;
+		else
+			rest = g_list_prepend (rest, widget);
+	}
+
+	rest = g_list_reverse (rest);
+	for (i = 0, list = rest; i < n && list; i++)
+		if (order[i] == NULL)
+		{
+			order[i] = list->data;
+			list     = list->next;
+		}
+	g_list_free (rest);
+
+	return order;
 }
 
 void
@@ -865,7 +928,8 @@ glade_gtk_box_set_child_property (GladeWidgetAdaptor *adaptor,
 				  GValue             *value)
 {
 	GladeWidget *gbox, *gchild, *gchild_iter;
-	GList       *children, *list;
+	GtkWidget  **order;
+	GList       *list;
 	gboolean     is_position;
 	gint         old_position, iter_position, new_position;
 	static       gboolean recursion = FALSE;
@@ -894,66 +958,38 @@ glade_gtk_box_set_child_property (GladeWidgetAdaptor *adaptor,
 
 	if (is_position && recursion == FALSE)
 	{
-		children = glade_widget_adaptor_get_children
-			(gbox->adaptor, container);
-
-		children = g_list_sort (children, (GCompareFunc)sort_box_children);
-
-		for (list = children; list; list = list->next)
+		/* Search for the child at the new position and move it 
+		 * to the old one, updating glade with the real value
+		 */
+		if (glade_property_superuser () == FALSE)
 		{
-			if ((gchild_iter = 
-			     glade_widget_get_from_gobject (list->data)) == NULL)
-				continue;
-
-			if (gchild_iter == gchild)
-			{
-				gtk_box_reorder_child (GTK_BOX (container),
-						       GTK_WIDGET (child),
-						       new_position);
-				continue;
-			}
-
-			/* Get the old value from glade */
-			glade_widget_pack_property_get
-				(gchild_iter, "position", &iter_position);
-
-			/* Search for the child at the old position and update it */
-			if (iter_position == new_position &&
-			    glade_property_superuser () == FALSE)
+			for (list = GTK_BOX (container)->children; list; list = list->next)
 			{
-				/* Update glade with the real value */
-				recursion = TRUE;
-				glade_widget_pack_property_set
-					(gchild_iter, "position", old_position);
-				recursion = FALSE;
-				continue;
+				gchild_iter = glade_widget_get_from_gobject 
+					(((GtkBoxChild *)list->data)->widget);
+
+				if (gchild_iter == NULL || gchild_iter == gchild)
+					continue;
+
+				glade_widget_pack_property_get
+					(gchild_iter, "position", &iter_position);
+
+				if (iter_position == new_position)
+				{
+					recursion = TRUE;
+					glade_widget_pack_property_set
+						(gchild_iter, "position", old_position);
+					recursion = FALSE;
+					break;
+				}
 			}
-			else
-			{
-				gtk_box_reorder_child (GTK_BOX (container),
-						       GTK_WIDGET (list->data),
-						       iter_position);
-			}
-		}
-
-		for (list = children; list; list = list->next)
-		{
-			if ((gchild_iter = 
-			     glade_widget_get_from_gobject (list->data)) == NULL)
-				continue;
-
-			/* Refresh values yet again */
-			glade_widget_pack_property_get
-				(gchild_iter, "position", &iter_position);
-
-			gtk_box_reorder_child (GTK_BOX (container),
-					       GTK_WIDGET (list->data),
-					       iter_position);
-
 		}
 
-		if (children)
-			g_list_free (children);
+		/* Apply the whole permutation at once */
+		order = glade_gtk_box_get_position_order 
+			(GTK_BOX (container), gchild, new_position);
+		glade_gtk_box_reorder (GTK_BOX (container), order);
+		g_free (order);
 	}
 
 	/* Chain Up */
@@ -965,7 +1001,9 @@ glade_gtk_box_set_child_property (GladeWidgetAdaptor *adaptor,
 								  property_name, 
 								  value);
 
-	gtk_container_check_resize (GTK_CONTAINER (container));
+	/* The outer call resizes once the swap is done */
+	if (!recursion)
+		gtk_container_check_resize (GTK_CONTAINER (container));
 
 }
 
@@ -987,39 +1025,15 @@ glade_gtk_box_get_property (GladeWidgetAdaptor *adaptor,
 		GWA_GET_CLASS (GTK_TYPE_CONTAINER)->get_property (adaptor, object, id, value);
 }
 
-static gint
-glade_gtk_box_get_first_blank (GtkBox *box)
-{
-	GList       *child;
-	GladeWidget *gwidget;
-	gint         position;
-	
-	for (child = box->children, position = 0;
-	     child && child->data;
-	     child = child->next, position++)
-	{
-		GtkWidget *widget = ((GtkBoxChild *) (child->data))->widget;
-
-		if ((gwidget = glade_widget_get_from_gobject (widget)) != NULL)
-		{
-			gint gwidget_position;
-			GladeProperty *property =
-				glade_widget_get_property (gwidget, "position");
-			gwidget_position = g_value_get_int (property->value);
-
-			if (gwidget_position > position)
-				return position;
-		}
-	}
-	return position;
-}
-
 static void
 glade_gtk_box_set_size (GObject *object, const GValue *value)
 {
 	GtkBox      *box;
-	GList       *child;
-	guint new_size, old_size, i;
+	GList       *child, *prev, *placeholders = NULL;
+	GtkWidget  **order;
+	GladeWidget *gwidget;
+	guint new_size, old_size, i, j;
+	gint  position;
 
 	box = GTK_BOX (object);
 	g_return_if_fail (GTK_IS_BOX (box));
@@ -1032,22 +1046,45 @@ glade_gtk_box_set_size (GObject *object, const GValue *value)
 
 	/* Ensure placeholders first...
 	 */
-	for (i = 0; i < new_size; i++)
+	if (new_size > old_size)
 	{
-		if (g_list_length(box->children) < (i + 1))
+		for (i = old_size; i < new_size; i++)
+			placeholders = g_list_prepend (placeholders, glade_placeholder_new ());
+
+		/* Merge the placeholders into the blank slots, a slot is blank
+		 * when the next GladeWidget child wants to sit further down.
+		 */
+		order = g_new0 (GtkWidget *, new_size);
+		for (child = box->children, j = 0; child; child = child->next)
 		{
-			GtkWidget *placeholder = glade_placeholder_new ();
-			gint       blank       = glade_gtk_box_get_first_blank (box);
+			GtkWidget *widget = ((GtkBoxChild *) (child->data))->widget;
 
-			gtk_container_add (GTK_CONTAINER (box), placeholder);
-			gtk_box_reorder_child (box, placeholder, blank);
+			if ((gwidget = glade_widget_get_from_gobject (widget)) != NULL &&
+			    glade_widget_pack_property_get (gwidget, "position", &position))
+			{
+				while (placeholders && position > (gint)j)
+				{
+					order[j++]   = placeholders->data;
+					placeholders = g_list_delete_link (placeholders, placeholders);
+				}
+			}
+			order[j++] = widget;
 		}
+		for (; placeholders; placeholders = g_list_delete_link (placeholders, placeholders))
+			order[j++] = placeholders->data;
+
+		for (i = 0; i < new_size; i++)
+			if (order[i]->parent == NULL)
+				gtk_container_add (GTK_CONTAINER (box), order[i]);
+
+		glade_gtk_box_reorder (box, order);
+		g_free (order);
 	}
 
 	/* The box has shrunk. Remove the widgets that are on those slots */
 	for (child = g_list_last (box->children);
 	     child && old_size > new_size;
-	     child = g_list_last (box->children), old_size--)
+	     child = prev, old_size--)
 	{
 		GtkWidget *child_widget = ((GtkBoxChild *) (child->data))->widget;
 
@@ -1059,6 +1096,8 @@ glade_gtk_box_set_size (GObject *object, const GValue *value)
 		    GLADE_IS_PLACEHOLDER (child_widget) == FALSE)
 			break;
 
+		prev = child->prev;
+
 		g_object_ref (G_OBJECT (child_widget));
 		gtk_container_remove (GTK_CONTAINER (box), child_widget);
 		gtk_widget_destroy (child_widget);
@@ -1307,121 +1346,199 @@ static GladeGtkTableChild table_edit = { 0, };
 static GladeGtkTableChild table_cur_attach = { 0, };
 
 
+/* Row and column extents of a table, as derived from the allocations
+ * of its children. Every motion event of a drag or resize asks for them
+ * many times, so they are computed once per allocation and cached on
+ * the table's GladeWidget.
+ */
+typedef struct {
+	gint index;   /* row/column number, or -1 when no child covers it */
+	gint start;   /* first pixel of the row/column, relative to the table */
+	gint end;     /* one past the last pixel of the row/column */
+	gint origin;  /* where the threshold measure starts */
+	gint size;    /* row/column size used for the thresholds */
+} GladeGtkTableCell;
+
+typedef struct {
+	GladeGtkTableCell *cells[2];   /* columns, rows */
+	gint              *covered[2]; /* covered indices, sorted by position */
+	gint               n_cells[2];
+	gint               n_covered[2];
+} GladeGtkTableGeometry;
+
+#define TABLE_GEOMETRY_KEY "glade-gtk-table-geometry"
+
+static void
+glade_gtk_table_geometry_free (GladeGtkTableGeometry *geometry)
+{
+	gint i;
+
+	for (i = 0; i < 2; i++)
+	{
+		g_free (geometry->cells[i]);
+		g_free (geometry->covered[i]);
+	}
+	g_free (geometry);
+}
+
+static void
+glade_gtk_table_geometry_add_child (GladeGtkTableGeometry *geometry,
+				    GtkTable              *table,
+				    GtkTableChild         *tchild,
+				    gboolean               row)
+{
+	GladeGtkTableCell *cell;
+	gint               dx, dy, i, origin, size, span, base;
+
+	base = row ? tchild->top_attach : tchild->left_attach;
+	span = row ? (tchild->bottom_attach - tchild->top_attach) :
+		(tchild->right_attach - tchild->left_attach);
+	size = row ? (tchild->widget->allocation.height) :
+		(tchild->widget->allocation.width);
+
+	if (span <= 0)
+		return;
+
+	gtk_widget_translate_coordinates (GTK_WIDGET (table), tchild->widget,
+					  0, 0, &dx, &dy);
+	origin = row ? -dy : -dx;
+
+	for (i = base; i < base + span && i < geometry->n_cells[row]; i++)
+	{
+		cell = &geometry->cells[row][i];
+
+		/* The first child found in a row/column describes it */
+		if (cell->index >= 0)
+			continue;
+
+		cell->index  = i;
+		cell->start  = origin + ((i - base) * size + span - 1) / span;
+		cell->end    = origin + ((i - base + 1) * size + span - 1) / span;
+		cell->size   = size / span;
+		cell->origin = origin + (i - base) * cell->size;
+	}
+}
+
+static GladeGtkTableGeometry *
+glade_gtk_table_geometry_new (GtkTable *table)
+{
+	GladeGtkTableGeometry *geometry = g_new0 (GladeGtkTableGeometry, 1);
+	GList                 *list;
+	gint                   row, i;
+
+	geometry->n_cells[FALSE] = table->ncols;
+	geometry->n_cells[TRUE]  = table->nrows;
+
+	for (row = 0; row < 2; row++)
+	{
+		geometry->cells[row]   = g_new (GladeGtkTableCell, geometry->n_cells[row]);
+		geometry->covered[row] = g_new (gint, geometry->n_cells[row]);
+
+		for (i = 0; i < geometry->n_cells[row]; i++)
+			geometry->cells[row][i].index = -1;
+
+		for (list = table->children; list; list = list->next)
+			glade_gtk_table_geometry_add_child (geometry, table, 
+							    list->data, row);
+
+		for (i = 0; i < geometry->n_cells[row]; i++)
+			if (geometry->cells[row][i].index >= 0)
+				geometry->covered[row][geometry->n_covered[row]++] = i;
+	}
+	return geometry;
+}
+
+static void
+glade_gtk_table_geometry_invalidate (GtkWidget     *table,
+				     GtkAllocation *allocation,
+				     GladeWidget   *gtable)
+{
+	g_object_set_data (G_OBJECT (gtable), TABLE_GEOMETRY_KEY, NULL);
+}
+
+static GladeGtkTableGeometry *
+glade_gtk_table_get_geometry (GladeWidget *gtable, GtkTable *table)
+{
+	GladeGtkTableGeometry *geometry;
+
+	geometry = g_object_get_data (G_OBJECT (gtable), TABLE_GEOMETRY_KEY);
+
+	if (geometry == NULL ||
+	    geometry->n_cells[FALSE] != table->ncols ||
+	    geometry->n_cells[TRUE]  != table->nrows)
+	{
+		geometry = glade_gtk_table_geometry_new (table);
+		g_object_set_data_full (G_OBJECT (gtable), TABLE_GEOMETRY_KEY, geometry,
+					(GDestroyNotify)glade_gtk_table_geometry_free);
+	}
+	return geometry;
+}
+
 /* Takes a point (x or y depending on 'row') relative to
  * table, and returns the row or column in which the point
  * was found.
  */
 static gint
-glade_gtk_table_get_row_col_from_point (GtkTable *table,
-					gboolean  row,
-					gint      point)
+glade_gtk_table_get_row_col_from_point (GladeGtkTableGeometry *geometry,
+					gboolean               row,
+					gint                   point)
 {
-	GtkTableChild *tchild;
-	GList         *list;
-	gint           span, trans_point, size, base, end;
+	GladeGtkTableCell *cell;
+	gint               lo = 0, hi = geometry->n_covered[row] - 1, mid;
 
-	for (list = table->children; list; list = list->next)
+	/* Find the last row/column starting at or before point */
+	while (lo <= hi)
 	{
-		tchild = list->data;
+		mid  = (lo + hi) / 2;
+		cell = &geometry->cells[row][geometry->covered[row][mid]];
 
-		if (row)
-			gtk_widget_translate_coordinates 
-				(GTK_WIDGET (table), tchild->widget,
-				 0, point, NULL, &trans_point);
+		if (cell->start <= point)
+			lo = mid + 1;
 		else
-			gtk_widget_translate_coordinates
-				(GTK_WIDGET (table), tchild->widget,
-				 point, 0, &trans_point, NULL);
-		
-		/* Find any widget in our row/column
-		 */
-		end = row ? 
-			tchild->widget->allocation.height :
-			tchild->widget->allocation.width;
+			hi = mid - 1;
+	}
 
-		if (trans_point >= 0 &&
-		    /* should be trans_point < end ... test FIXME ! */
-		    trans_point <  end)
-		{
-			base = row ? tchild->top_attach : tchild->left_attach;
-			size = row ? (tchild->widget->allocation.height) :
-				(tchild->widget->allocation.width);
-			span = row ? (tchild->bottom_attach - tchild->top_attach) :
-				(tchild->right_attach - tchild->left_attach);
+	if (hi < 0)
+		return -1;
 
-			return base + (trans_point * span / size);
-		}
-	}
+	cell = &geometry->cells[row][geometry->covered[row][hi]];
 
-	return -1;
+	return point < cell->end ? cell->index : -1;
 }
 
 
 static gboolean
-glade_gtk_table_point_crosses_threshold (GtkTable      *table,
-					 gboolean       row,
-					 gint           num,
-					 GladeTableDir  dir,
-					 gint           point)
+glade_gtk_table_point_crosses_threshold (GladeGtkTableGeometry *geometry,
+					 gboolean               row,
+					 gint                   num,
+					 GladeTableDir          dir,
+					 gint                   point)
 {
+	GladeGtkTableCell *cell;
+	gint               trans_point;
 
-	GtkTableChild *tchild;
-	GList         *list;
-	gint           span, trans_point, size, rowcol_size, base;
-	
-	for (list = table->children; list; list = list->next)
-	{
-		tchild = list->data;
-	
-		/* Find any widget in our row/column
-		 */
-		if ((row && num >= tchild->top_attach && num < tchild->bottom_attach) ||
-		    (!row && num >= tchild->left_attach && num < tchild->right_attach))
-		{
+	if (num < 0 || num >= geometry->n_cells[row])
+		return FALSE;
 
-			if (row)
-				gtk_widget_translate_coordinates 
-					(GTK_WIDGET (table), tchild->widget,
-					 0, point, NULL, &trans_point);
-			else
-				gtk_widget_translate_coordinates
-					(GTK_WIDGET (table), tchild->widget,
-					 point, 0, &trans_point, NULL);
-
-			span = row ? (tchild->bottom_attach - tchild->top_attach) :
-				(tchild->right_attach - tchild->left_attach);
-			size = row ? (tchild->widget->allocation.height) :
-				(tchild->widget->allocation.width);
-
-			base         = row ? tchild->top_attach : tchild->left_attach;
-			rowcol_size  = size / span;
-			trans_point -= (num - base) * rowcol_size;
-
-#if 0
-			g_print ("dir: %s, widget size: %d, rowcol size: %d, "
-				 "requested rowcol: %d, widget base rowcol: %d, trim: %d, "
-				 "widget point: %d, thresh: %d\n",
-				 dir == DIR_UP ? "up" : dir == DIR_DOWN ? "down" :
-				 dir == DIR_LEFT ? "left" : "right",
-				 size, rowcol_size, num, base, (num - base) * rowcol_size,
-				 trans_point,
-				 dir == DIR_UP || dir == DIR_LEFT ?
-				 (rowcol_size / 2) :
-				 (rowcol_size / 2));
-#endif
-			switch (dir)
-			{
-			case DIR_UP:
-			case DIR_LEFT:
-				return trans_point <= (rowcol_size / 2);
-			case DIR_DOWN:
-			case DIR_RIGHT:
-				return trans_point >= (rowcol_size / 2);
-			default:
-				break;
-			}
-		}
-		
+	cell = &geometry->cells[row][num];
+
+	/* No widget in our row/column
+	 */
+	if (cell->index < 0)
+		return FALSE;
+
+	trans_point = point - cell->origin;
+
+	switch (dir)
+	{
+	case DIR_UP:
+	case DIR_LEFT:
+		return trans_point <= (cell->size / 2);
+	case DIR_DOWN:
+	case DIR_RIGHT:
+		return trans_point >= (cell->size / 2);
+	default:
+		break;
 	}
 	return FALSE;
 }
@@ -1432,15 +1549,18 @@ glade_gtk_table_get_attachments (GladeFixed         *fixed,
 				 GdkRectangle       *rect,
 				 GladeGtkTableChild *configure)
 {
+	GladeGtkTableGeometry *geometry;
 	gint  center_x, center_y, row, column;
 	center_x  = rect->x + (rect->width / 2);
 	center_y  = rect->y + (rect->height / 2);
 
+	geometry = glade_gtk_table_get_geometry (GLADE_WIDGET (fixed), table);
+
 	column = glade_gtk_table_get_row_col_from_point
-		(table, FALSE, center_x);
+		(geometry, FALSE, center_x);
 
 	row = glade_gtk_table_get_row_col_from_point
-		(table, TRUE, center_y);
+		(geometry, TRUE, center_y);
 
 	/* its a start, now try to grow when the rect extents
 	 * reach at least half way into the next row/column 
@@ -1463,7 +1583,7 @@ glade_gtk_table_get_attachments (GladeFixed         *fixed,
 				break;
 
 			if (glade_gtk_table_point_crosses_threshold 
-			    (table, FALSE, configure->left_attach -1,
+			    (geometry, FALSE, configure->left_attach -1,
 			     DIR_LEFT, rect->x) == FALSE)
 				break;
 
@@ -1481,7 +1601,7 @@ glade_gtk_table_get_attachments (GladeFixed         *fixed,
 				break;
 
 			if (glade_gtk_table_point_crosses_threshold
-			    (table, FALSE, configure->right_attach,
+			    (geometry, FALSE, configure->right_attach,
 			     DIR_RIGHT, rect->x + rect->width) == FALSE)
 				break;
 
@@ -1498,7 +1618,7 @@ glade_gtk_table_get_attachments (GladeFixed         *fixed,
 				break;
 
 			if (glade_gtk_table_point_crosses_threshold 
-			    (table, TRUE, configure->top_attach -1,
+			    (geometry, TRUE, configure->top_attach -1,
 			     DIR_UP, rect->y) == FALSE)
 				break;
 
@@ -1516,7 +1636,7 @@ glade_gtk_table_get_attachments (GladeFixed         *fixed,
 				break;
 
 			if (glade_gtk_table_point_crosses_threshold
-			    (table, TRUE, configure->bottom_attach,
+			    (geometry, TRUE, configure->bottom_attach,
 			     DIR_DOWN, rect->y + rect->height) == FALSE)
 				break;
 
@@ -1614,6 +1734,9 @@ glade_gtk_table_configure_begin (GladeFixed  *fixed,
 
 	memcpy (&table_cur_attach, &table_edit, TABLE_CHILD_CMP_SIZE);
 
+	/* Compute the row/column extents once for this drag/resize */
+	glade_gtk_table_get_geometry (GLADE_WIDGET (fixed), GTK_TABLE (table));
+
 	return TRUE;
 }
 
@@ -1714,6 +1837,9 @@ glade_gtk_table_post_create (GladeWidgetAdaptor *adaptor,
 
 	g_signal_connect (G_OBJECT (gwidget), "configure-end",
 			  G_CALLBACK (glade_gtk_table_configure_end), container);
+
+	g_signal_connect (container, "size-allocate",
+			  G_CALLBACK (glade_gtk_table_geometry_invalidate), gwidget);
 }
 
 static gboolean
@@ -2355,13 +2481,20 @@ typedef struct
 	gint   pages;
 	gint   page;
 
-	GList *children;
-	GList *tabs;
+	/* The extracted range of pages, project pages and tabs
+	 * are slotted at (position - first).
+	 */
+	gint        first;
+	gint        n_slots;
+	GtkWidget **children;
+	GtkWidget **tabs;
 
 	GList *extra_children;
 	GList *extra_tabs;
 } NotebookChildren;
 
+#define NOTEBOOK_TAB_INDEX "glade-gtk-notebook-tab-index"
+
 static gboolean glade_gtk_notebook_setting_position = FALSE;
 
 static gint
@@ -2381,37 +2514,106 @@ notebook_child_compare_func (GtkWidget *widget_a, GtkWidget *widget_b)
 	return pos_a - pos_b;
 }
 
-static gint
-notebook_find_child (GtkWidget *check,
-		     gpointer   cmp_pos_p)
+/* Returns the tab-label -> page index map kept on the notebook's
+ * GladeWidget, entries are only trusted after checking them against
+ * the notebook (see notebook_search_tab()).
+ */
+static GHashTable *
+notebook_get_tab_index (GtkNotebook *notebook)
 {
-	GladeWidget *gcheck;
-	gint         position = 0, cmp_pos = GPOINTER_TO_INT (cmp_pos_p);
-		
-	gcheck  = glade_widget_get_from_gobject (check);
-	g_assert (gcheck);
-	
-	glade_widget_pack_property_get (gcheck, "position", &position);
+	GladeWidget *gnotebook;
+	GHashTable  *index;
+
+	if ((gnotebook = glade_widget_get_from_gobject (notebook)) == NULL)
+		return NULL;
+
+	if ((index = g_object_get_data (G_OBJECT (gnotebook), NOTEBOOK_TAB_INDEX)) == NULL)
+	{
+		index = g_hash_table_new (NULL, NULL);
+		g_object_set_data_full (G_OBJECT (gnotebook), NOTEBOOK_TAB_INDEX, index,
+					(GDestroyNotify)g_hash_table_destroy);
+	}
+	return index;
+}
+
+static void
+notebook_index_tab (GtkNotebook *notebook,
+		    GtkWidget   *tab,
+		    gint         position)
+{
+	GHashTable *index;
+
+	if (tab && (index = notebook_get_tab_index (notebook)) != NULL)
+		g_hash_table_insert (index, tab, GINT_TO_POINTER (position));
+}
+
+/* Collects the tab label of every page in a single walk over
+ * the notebook (forall lists each page followed by its tab).
+ */
+static GtkWidget **
+notebook_list_tabs (GtkNotebook *notebook)
+{
+	GList      *pages, *all, *page, *l;
+	GtkWidget **tabs;
+	gint        position = -1;
+
+	pages = gtk_container_get_children (GTK_CONTAINER (notebook));
+	all   = glade_util_container_get_all_children (GTK_CONTAINER (notebook));
+	tabs  = g_new0 (GtkWidget *, g_list_length (pages) + 1);
+
+	for (page = pages, l = all; l; l = l->next)
+	{
+		if (page && l->data == page->data)
+		{
+			position++;
+			page = page->next;
+		}
+		else if (position >= 0)
+			tabs[position] = l->data;
+	}
+
+	g_list_free (pages);
+	g_list_free (all);
 
-	return position - cmp_pos;
+	return tabs;
 }
 
 static gint
 notebook_search_tab (GtkNotebook *notebook,
 		     GtkWidget   *tab)
 {
-	GtkWidget *page;
-	gint       i;
+	GHashTable *index = notebook_get_tab_index (notebook);
+	GtkWidget  *page, **tabs;
+	gpointer    value;
+	gint        i, position = -1;
 
-	for (i = 0; i < gtk_notebook_get_n_pages (notebook); i++)
+	if (index && g_hash_table_lookup_extended (index, tab, NULL, &value))
 	{
-		page = gtk_notebook_get_nth_page (notebook, i);
+		i = GPOINTER_TO_INT (value);
 
-		if (tab == gtk_notebook_get_tab_label (notebook, page))
+		if (i < gtk_notebook_get_n_pages (notebook) &&
+		    (page = gtk_notebook_get_nth_page (notebook, i)) != NULL &&
+		    gtk_notebook_get_tab_label (notebook, page) == tab)
 			return i;
 	}
-	g_critical ("Unable to find tab position in a notebook");
-	return -1;
+
+	/* Stale or missing entry, reindex all tabs at once */
+	if (index)
+		g_hash_table_remove_all (index);
+
+	tabs = notebook_list_tabs (notebook);
+	for (i = 0; i < gtk_notebook_get_n_pages (notebook); i++)
+	{
+		notebook_index_tab (notebook, tabs[i], i);
+		if (tabs[i] == tab)
+			position = i;
+	}
+	g_free (tabs);
+
+	if (position < 0)
+		g_critical ("Unable to find tab position in a notebook");
+
+	return position;
 }
 
 static GtkWidget *
@@ -2450,20 +2652,12 @@ notebook_get_filler (NotebookChildren *nchildren, gboolean page)
 }
 
 static GtkWidget *
-notebook_get_page (NotebookChildren *nchildren, gint position)
+notebook_get_page (NotebookChildren *nchildren, gint slot)
 {
-	GList     *node;
-	GtkWidget *widget = NULL;
+	GtkWidget *widget;
 
-	if ((node = g_list_find_custom
-	     (nchildren->children,
-	      GINT_TO_POINTER (position),
-	      (GCompareFunc)notebook_find_child)) != NULL)
-	{
-		widget = node->data;
-		nchildren->children = 
-			g_list_remove (nchildren->children, widget);
-	}
+	if ((widget = nchildren->children[slot]) != NULL)
+		nchildren->children[slot] = NULL;
 	else
 		widget = notebook_get_filler (nchildren, TRUE);
 
@@ -2471,104 +2665,152 @@ notebook_get_page (NotebookChildren *nchildren, gint position)
 }
 
 static GtkWidget *
-notebook_get_tab (NotebookChildren *nchildren, gint position)
+notebook_get_tab (NotebookChildren *nchildren, gint slot)
 {
-	GList     *node;
-	GtkWidget *widget = NULL;
+	GtkWidget *widget;
 
-	if ((node = g_list_find_custom
-	     (nchildren->tabs,
-	      GINT_TO_POINTER (position),
-	      (GCompareFunc)notebook_find_child)) != NULL)
-	{
-		widget = node->data;
-		nchildren->tabs = 
-			g_list_remove (nchildren->tabs, widget);
-	}
+	if ((widget = nchildren->tabs[slot]) != NULL)
+		nchildren->tabs[slot] = NULL;
 	else
 		widget = notebook_get_filler (nchildren, FALSE);
 
 	return widget;
 }
 
+/* Slots a project page or tab at its "position", children that
+ * fall outside the extracted range or collide with another child
+ * are kept aside to fill the gaps.
+ */
+static void
+notebook_slot_child (NotebookChildren *nchildren,
+		     GtkWidget        *child)
+{
+	GladeWidget  *gchild;
+	GtkWidget   **slots;
+	GList       **extra;
+	gint          position = 0, slot;
+
+	if (child == NULL ||
+	    (gchild = glade_widget_get_from_gobject (child)) == NULL)
+		return;
+
+	if (g_object_get_data (G_OBJECT (child), "special-child-type") == NULL)
+	{
+		slots = nchildren->children;
+		extra = &nchildren->extra_children;
+	}
+	else
+	{
+		slots = nchildren->tabs;
+		extra = &nchildren->extra_tabs;
+	}
+
+	glade_widget_pack_property_get (gchild, "position", &position);
+
+	g_object_ref (G_OBJECT (child));
+
+	slot = position - nchildren->first;
+	if (slot >= 0 && slot < nchildren->n_slots && slots[slot] == NULL)
+		slots[slot] = child;
+	else
+		*extra = g_list_insert_sorted
+			(*extra, child, (GCompareFunc)notebook_child_compare_func);
+}
+
+static void
+notebook_unslot_child (NotebookChildren *nchildren,
+		       GtkWidget        *child)
+{
+	gint i;
+
+	for (i = 0; i < nchildren->n_slots; i++)
+	{
+		if (nchildren->children[i] == child)
+			nchildren->children[i] = NULL;
+		else if (nchildren->tabs[i] == child)
+			nchildren->tabs[i] = NULL;
+		else
+			continue;
+
+		g_object_unref (child);
+		return;
+	}
+
+	if (g_list_find (nchildren->extra_children, child))
+	{
+		nchildren->extra_children =
+			g_list_remove (nchildren->extra_children, child);
+		g_object_unref (child);
+	}
+	else if (g_list_find (nchildren->extra_tabs, child))
+	{
+		nchildren->extra_tabs =
+			g_list_remove (nchildren->extra_tabs, child);
+		g_object_unref (child);
+	}
+}
+
+/* Pulls pages @first through @last (and their tabs) out of the notebook,
+ * pages outside that range are left untouched.
+ */
 static NotebookChildren *
-glade_gtk_notebook_extract_children (GtkWidget *notebook)
+glade_gtk_notebook_extract_children (GtkWidget *notebook,
+				     gint       first,
+				     gint       last)
 {
 	NotebookChildren *nchildren;
-	gchar            *special_child_type;
-	GList            *list, *children =
-		glade_util_container_get_all_children (GTK_CONTAINER (notebook));
-	GladeWidget      *gchild;
-	GtkWidget        *page;
-	gint              position = 0;
+	GList            *list, *children;
+	GtkWidget        *page, **tabs;
+	gint              i;
 
 	nchildren        = g_new0 (NotebookChildren, 1);
 	nchildren->pages = gtk_notebook_get_n_pages (GTK_NOTEBOOK (notebook));
 	nchildren->page  = gtk_notebook_get_current_page (GTK_NOTEBOOK (notebook));
-		
-	/* Ref all the project widgets and build returned list first */
-	for (list = children; list; list = list->next)
-	{
-		if ((gchild = glade_widget_get_from_gobject (list->data)) != NULL)
-		{
-			special_child_type =
-				g_object_get_data (G_OBJECT (list->data),
-						   "special-child-type");
 
-			glade_widget_pack_property_get (gchild, "position", &position);
+	first = CLAMP (first, 0, nchildren->pages);
+	last  = CLAMP (last, first - 1, nchildren->pages - 1);
 
-			g_object_ref (G_OBJECT (list->data));
+	nchildren->first    = first;
+	nchildren->n_slots  = last - first + 1;
+	nchildren->children = g_new0 (GtkWidget *, nchildren->n_slots + 1);
+	nchildren->tabs     = g_new0 (GtkWidget *, nchildren->n_slots + 1);
 
-			/* Sort it into the proper struct member
-			 */
-			if (special_child_type == NULL)
-			{
-				if (g_list_find_custom (nchildren->children,
-							GINT_TO_POINTER (position),
-							(GCompareFunc)notebook_find_child))
-					nchildren->extra_children =
-						g_list_insert_sorted
-						(nchildren->extra_children, list->data,
-						 (GCompareFunc)notebook_child_compare_func);
-				else
-					nchildren->children =
-						g_list_insert_sorted
-						(nchildren->children, list->data,
-						 (GCompareFunc)notebook_child_compare_func);
-			} else {
-				if (g_list_find_custom (nchildren->tabs,
-							GINT_TO_POINTER (position),
-							(GCompareFunc)notebook_find_child))
-					nchildren->extra_tabs =
-						g_list_insert_sorted
-						(nchildren->extra_tabs, list->data,
-						 (GCompareFunc)notebook_child_compare_func);
-				else
-					nchildren->tabs =
-						g_list_insert_sorted
-						(nchildren->tabs, list->data,
-						 (GCompareFunc)notebook_child_compare_func);
-			}
-		}
+	/* Ref the project widgets in range and slot them by position first */
+	children = gtk_container_get_children (GTK_CONTAINER (notebook));
+	tabs     = notebook_list_tabs (GTK_NOTEBOOK (notebook));
+
+	for (i = first, list = g_list_nth (children, first);
+	     list && i <= last; i++, list = list->next)
+	{
+		notebook_slot_child (nchildren, list->data);
+		notebook_slot_child (nchildren, tabs[i]);
 	}
 
-	/* Remove all pages, resulting in the unparenting of all widgets including tab-labels.
+	g_list_free (children);
+	g_free (tabs);
+
+	/* Remove the pages in range, resulting in the unparenting of
+	 * their widgets including tab-labels.
 	 */
-	while (gtk_notebook_get_n_pages (GTK_NOTEBOOK (notebook)) > 0)
+	for (i = first; i <= last; i++)
 	{
-		page = gtk_notebook_get_nth_page (GTK_NOTEBOOK (notebook), 0);
+		page = gtk_notebook_get_nth_page (GTK_NOTEBOOK (notebook), first);
 
 		/* Explicitly remove the tab label first */
 		gtk_notebook_set_tab_label (GTK_NOTEBOOK (notebook), page, NULL);
-		gtk_notebook_remove_page (GTK_NOTEBOOK (notebook), 0);
+		gtk_notebook_remove_page (GTK_NOTEBOOK (notebook), first);
 	}
 
-	if (children)
-		g_list_free (children);
-
 	return nchildren;
 }
 
+static NotebookChildren *
+glade_gtk_notebook_extract_all_children (GtkWidget *notebook)
+{
+	return glade_gtk_notebook_extract_children
+		(notebook, 0, gtk_notebook_get_n_pages (GTK_NOTEBOOK (notebook)) - 1);
+}
+
 static void
 glade_gtk_notebook_insert_children (GtkWidget *notebook, NotebookChildren *nchildren)
 {
@@ -2577,14 +2819,17 @@ glade_gtk_notebook_insert_children (GtkWidget *notebook, NotebookChildren *nchil
 	/*********************************************************
                                 INSERT PAGES
 	 *********************************************************/
-	for (i = 0; i < nchildren->pages; i++)
+	for (i = 0; i < nchildren->n_slots; i++)
 	{
 		GtkWidget *page = notebook_get_page (nchildren, i);
 		GtkWidget *tab  = notebook_get_tab (nchildren, i);
 
-		gtk_notebook_insert_page   (GTK_NOTEBOOK (notebook), page, NULL, i);
+		gtk_notebook_insert_page   (GTK_NOTEBOOK (notebook), page, NULL, 
+					    nchildren->first + i);
 		gtk_notebook_set_tab_label (GTK_NOTEBOOK (notebook), page, tab);
 
+		notebook_index_tab (GTK_NOTEBOOK (notebook), tab, nchildren->first + i);
+
 		g_object_unref (G_OBJECT (page));
 		g_object_unref (G_OBJECT (tab));
 	}
@@ -2592,24 +2837,15 @@ glade_gtk_notebook_insert_children (GtkWidget *notebook, NotebookChildren *nchil
 	/* Stay on the same page */
 	gtk_notebook_set_current_page (GTK_NOTEBOOK (notebook), nchildren->page);
 	
-	/* Free the original lists now */
-	if (nchildren->children)
-		g_list_free (nchildren->children);
-
-	if (nchildren->tabs)
-		g_list_free (nchildren->tabs);
-
-	if (nchildren->children       ||
-	    nchildren->tabs           ||
-	    nchildren->extra_children ||
+	if (nchildren->extra_children ||
 	    nchildren->extra_tabs)
 		g_critical ("Unbalanced children when inserting notebook children"
-			    " (pages: %d tabs: %d extra pages: %d extra tabs %d)",
-			    g_list_length (nchildren->children),
-			    g_list_length (nchildren->tabs),
+			    " (extra pages: %d extra tabs %d)",
 			    g_list_length (nchildren->extra_children),
 			    g_list_length (nchildren->extra_tabs));
 	
+	g_free (nchildren->children);
+	g_free (nchildren->tabs);
 	g_free (nchildren);
 }
 
@@ -2637,29 +2873,6 @@ glade_gtk_notebook_post_create (GladeWidgetAdaptor *adaptor,
 			  G_CALLBACK (glade_gtk_notebook_switch_page), NULL);
 }
 
-static gint
-glade_gtk_notebook_get_first_blank_page (GtkNotebook *notebook)
-{
-	GladeWidget *gwidget;
-	GtkWidget   *widget;
-	gint         position;
-
-	for (position = 0; position < gtk_notebook_get_n_pages (notebook); position++)
-	{
-		widget = gtk_notebook_get_nth_page (notebook, position);
-		if ((gwidget = glade_widget_get_from_gobject (widget)) != NULL)
-		{
- 			GladeProperty *property =
-				glade_widget_get_property (gwidget, "position");
-			gint gwidget_position = g_value_get_int (property->value);
-
-			if ((gwidget_position - position) > 0)
-				return position;
-		}
-	}
-	return position;
-}
-
 static void
 glade_gtk_notebook_set_n_pages (GObject *object, const GValue *value)
 {
@@ -2684,14 +2897,32 @@ glade_gtk_notebook_set_n_pages (GObject *object, const GValue *value)
 	/* Ensure base size of notebook */
 	if (glade_widget_superuser () == FALSE)
 	{
+		GList *children, *list;
+		gint   position = 0;
+
+		/* New pages fill the blanks left before project pages that sit
+		 * further along than their index, walk the pages once and insert
+		 * each placeholder (with its tab) as we reach the next blank.
+		 */
+		children = list = gtk_container_get_children (GTK_CONTAINER (notebook));
+
 		for (i = gtk_notebook_get_n_pages (notebook); i < new_size; i++)
 		{
-			gint position = glade_gtk_notebook_get_first_blank_page (notebook);
 			GtkWidget *placeholder = glade_placeholder_new ();
+			GladeWidget *gpage, *glabel;
 			gchar *str;
 
-			GladeWidget *glabel =
-				glade_widget_adaptor_create_widget
+			for (; list; list = list->next, position++)
+			{
+				gint page_position = 0;
+
+				if ((gpage = glade_widget_get_from_gobject (list->data)) != NULL &&
+				    glade_widget_pack_property_get (gpage, "position", &page_position) &&
+				    page_position > position)
+					break;
+			}
+
+			glabel = glade_widget_adaptor_create_widget
 				(wadaptor, FALSE,
 				 "parent", widget, 
 				 "project", glade_widget_get_project (widget), 
@@ -2703,8 +2934,13 @@ glade_gtk_notebook_set_n_pages (GObject *object, const GValue *value)
 			g_object_set_data (glabel->object, "special-child-type", "tab");
 			gtk_widget_show (GTK_WIDGET (glabel->object));
 			
+			/* Insert the tab along with its page, add_child() leaves
+			 * children that are already parented here alone.
+			 */
 			gtk_notebook_insert_page (notebook, placeholder,
-						  NULL, position);
+						  GTK_WIDGET (glabel->object), position);
+			notebook_index_tab (notebook, GTK_WIDGET (glabel->object), position);
+			position++;
 
 			/* Must tell the project that were adding a widget (so that
 			 * saving works properly & it appears in the inspector properly)
@@ -2716,6 +2952,8 @@ glade_gtk_notebook_set_n_pages (GObject *object, const GValue *value)
 			 */
 			glade_widget_add_child (widget, glabel, FALSE);
 		}
+
+		g_list_free (children);
 	}
 
 	old_size = gtk_notebook_get_n_pages (GTK_NOTEBOOK (notebook));
@@ -2805,6 +3043,36 @@ glade_gtk_notebook_verify_property (GladeWidgetAdaptor *adaptor,
 	return TRUE;
 }
 
+/* Whether the page (or tab) at @position can take a new project
+ * child without displacing another one.
+ */
+static gboolean
+notebook_slot_is_free (GtkNotebook *notebook,
+		       gint         position,
+		       gboolean     tab)
+{
+	GtkWidget *widget;
+
+	if (position < 0 || position >= gtk_notebook_get_n_pages (notebook))
+		return FALSE;
+
+	widget = gtk_notebook_get_nth_page (notebook, position);
+	if (tab)
+		widget = gtk_notebook_get_tab_label (notebook, widget);
+
+	return widget == NULL || glade_widget_get_from_gobject (widget) == NULL;
+}
+
+static gint
+notebook_child_get_index (GtkNotebook *notebook,
+			  GtkWidget   *child)
+{
+	if (g_object_get_data (G_OBJECT (child), "special-child-type") != NULL)
+		return notebook_search_tab (notebook, child);
+	else
+		return gtk_notebook_page_num (notebook, child);
+}
+
 void 
 glade_gtk_notebook_add_child (GladeWidgetAdaptor *adaptor,
 			      GObject            *object, 
@@ -2832,6 +3100,7 @@ glade_gtk_notebook_add_child (GladeWidgetAdaptor *adaptor,
 			last_page = gtk_notebook_get_nth_page (notebook, num_page - 1);
 			gtk_notebook_set_tab_label (notebook, last_page,
 						    GTK_WIDGET (child));
+			notebook_index_tab (notebook, GTK_WIDGET (child), num_page - 1);
 		}
 		else
 		{
@@ -2856,48 +3125,29 @@ glade_gtk_notebook_add_child (GladeWidgetAdaptor *adaptor,
 			else
 				g_object_unref (G_OBJECT (child));
 		}
+		/* Tabs inserted along with their page by set_n_pages() */
+		else if (GTK_WIDGET (child)->parent == GTK_WIDGET (notebook))
+			return;
 		else
 		{
 			gwidget = glade_widget_get_from_gobject (child);
 			g_assert (gwidget);
 
 			glade_widget_pack_property_get (gwidget, "position", &position);
-			
-			nchildren = glade_gtk_notebook_extract_children (GTK_WIDGET (notebook));
-			
-			if (g_object_get_data (child, "special-child-type") != NULL)
-			{
-				if (g_list_find_custom (nchildren->tabs,
-							GINT_TO_POINTER (position),
-							(GCompareFunc)notebook_find_child))
-					nchildren->extra_tabs =
-						g_list_insert_sorted
-						(nchildren->extra_tabs, child,
-						 (GCompareFunc)notebook_child_compare_func);
-				else
-					nchildren->tabs =
-						g_list_insert_sorted
-						(nchildren->tabs, child,
-						 (GCompareFunc)notebook_child_compare_func);
-			}
+
+			/* Only the page at the child's position is rebuilt, unless
+			 * its taken and the child has to fill a gap elsewhere.
+			 */
+			if (notebook_slot_is_free
+			    (notebook, position,
+			     g_object_get_data (child, "special-child-type") != NULL))
+				nchildren = glade_gtk_notebook_extract_children
+					(GTK_WIDGET (notebook), position, position);
 			else
-			{
-				if (g_list_find_custom (nchildren->children,
-							GINT_TO_POINTER (position),
-							(GCompareFunc)notebook_find_child))
-					nchildren->extra_children =
-						g_list_insert_sorted
-						(nchildren->extra_children, child,
-						 (GCompareFunc)notebook_child_compare_func);
-				else
-					nchildren->children =
-						g_list_insert_sorted
-						(nchildren->children, child,
-						 (GCompareFunc)notebook_child_compare_func);
-			}
+				nchildren = glade_gtk_notebook_extract_all_children
+					(GTK_WIDGET (notebook));
 
-			/* Takes an explicit reference when sitting on the list */
-			g_object_ref (child);
+			notebook_slot_child (nchildren, GTK_WIDGET (child));
 			
 			glade_gtk_notebook_insert_children (GTK_WIDGET (notebook), nchildren);
 		}
@@ -2910,33 +3160,17 @@ glade_gtk_notebook_remove_child (GladeWidgetAdaptor *adaptor,
 				 GObject            *child)
 {
 	NotebookChildren *nchildren;
+	gint              position;
 
-	nchildren = glade_gtk_notebook_extract_children (GTK_WIDGET (object));
-			
-	if (g_list_find (nchildren->children, child))
-	{
-		nchildren->children =
-			g_list_remove (nchildren->children, child);
-		g_object_unref (child);
-	}
-	else if (g_list_find (nchildren->extra_children, child))
-	{
-		nchildren->extra_children =
-			g_list_remove (nchildren->extra_children, child);
-		g_object_unref (child);
-	}
-	else if (g_list_find (nchildren->tabs, child))
-	{
-		nchildren->tabs =
-			g_list_remove (nchildren->tabs, child);
-		g_object_unref (child);
-	}
-	else if (g_list_find (nchildren->extra_tabs, child))
-	{
-		nchildren->extra_tabs =
-			g_list_remove (nchildren->extra_tabs, child);
-		g_object_unref (child);
-	}
+	position = notebook_child_get_index (GTK_NOTEBOOK (object), GTK_WIDGET (child));
+
+	if (position >= 0)
+		nchildren = glade_gtk_notebook_extract_children
+			(GTK_WIDGET (object), position, position);
+	else
+		nchildren = glade_gtk_notebook_extract_all_children (GTK_WIDGET (object));
+
+	notebook_unslot_child (nchildren, GTK_WIDGET (child));
 	
 	glade_gtk_notebook_insert_children (GTK_WIDGET (object), nchildren);
 	
@@ -3017,6 +3251,7 @@ glade_gtk_notebook_set_child_property (GladeWidgetAdaptor *adaptor,
 				       const GValue       *value)
 {
 	NotebookChildren *nchildren;
+	gint              old_position, new_position;
 
 	if (strcmp (property_name, "position") == 0)
 	{
@@ -3025,8 +3260,22 @@ glade_gtk_notebook_set_child_property (GladeWidgetAdaptor *adaptor,
 		    glade_widget_superuser ())
 			return;
 		
-		/* Just rebuild the notebook, property values are already set at this point */
-		nchildren = glade_gtk_notebook_extract_children (GTK_WIDGET (container));
+		/* Just rebuild the pages between the old and new position,
+		 * property values are already set at this point
+		 */
+		old_position = notebook_child_get_index (GTK_NOTEBOOK (container),
+							 GTK_WIDGET (child));
+		new_position = g_value_get_int (value);
+
+		if (old_position >= 0)
+			nchildren = glade_gtk_notebook_extract_children
+				(GTK_WIDGET (container),
+				 MIN (old_position, new_position),
+				 MAX (old_position, new_position));
+		else
+			nchildren = glade_gtk_notebook_extract_all_children
+				(GTK_WIDGET (container));
+
 		glade_gtk_notebook_insert_children (GTK_WIDGET (container), nchildren);
 	}
 	/* packing properties are unsupported on tabs ... except "position" */
@@ -4504,6 +4753,93 @@ glade_gtk_menu_constructor (GType                  type,
 }
 
 
+/* -------------------------- Child position index ------------------------- */
+/* Menu shells and toolbars keep a child -> position map on their GladeWidget
+ * so that reading the "position" of every child stays linear, appending
+ * keeps it up to date and any other change simply drops it; children
+ * are removed from many places (destroying them removes them too) so
+ * removals are caught with the container's "remove" signal.
+ */
+#define GLADE_GTK_POSITION_INDEX "glade-gtk-position-index"
+
+static void
+glade_gtk_position_index_invalidate (GObject *container)
+{
+	GladeWidget *gcontainer;
+
+	if ((gcontainer = glade_widget_get_from_gobject (container)) != NULL)
+		g_object_set_data (G_OBJECT (gcontainer), GLADE_GTK_POSITION_INDEX, NULL);
+}
+
+static void
+glade_gtk_position_index_child_removed (GtkContainer *container,
+					GtkWidget    *child,
+					gpointer      data)
+{
+	glade_gtk_position_index_invalidate (G_OBJECT (container));
+}
+
+static void
+glade_gtk_position_index_append (GObject *container, GObject *child)
+{
+	GladeWidget *gcontainer;
+	GHashTable  *index;
+
+	if ((gcontainer = glade_widget_get_from_gobject (container)) != NULL &&
+	    (index = g_object_get_data (G_OBJECT (gcontainer), GLADE_GTK_POSITION_INDEX)) != NULL)
+		g_hash_table_insert (index, child, 
+				     GINT_TO_POINTER (g_hash_table_size (index)));
+}
+
+/* Returns the position of @child in @container, or -1 */
+static gint
+glade_gtk_position_index_lookup (GObject *container, GObject *child)
+{
+	GladeWidget *gcontainer;
+	GHashTable  *index;
+	GList       *children, *l;
+	gpointer     position;
+	gboolean     rebuilt = FALSE;
+	gint         i;
+
+	if ((gcontainer = glade_widget_get_from_gobject (container)) == NULL)
+		return -1;
+
+	while (TRUE)
+	{
+		if ((index = g_object_get_data (G_OBJECT (gcontainer), 
+						GLADE_GTK_POSITION_INDEX)) == NULL)
+		{
+			index = g_hash_table_new (NULL, NULL);
+
+			children = gtk_container_get_children (GTK_CONTAINER (container));
+			for (i = 0, l = children; l; l = l->next, i++)
+				g_hash_table_insert (index, l->data, GINT_TO_POINTER (i));
+			g_list_free (children);
+
+			g_object_set_data_full (G_OBJECT (gcontainer), 
+						GLADE_GTK_POSITION_INDEX, index,
+						(GDestroyNotify)g_hash_table_destroy);
+			rebuilt = TRUE;
+
+			/* Connect once, whatever number of times it gets rebuilt */
+			g_signal_handlers_disconnect_by_func 
+				(container, G_CALLBACK (glade_gtk_position_index_child_removed), NULL);
+			g_signal_connect (container, "remove",
+					  G_CALLBACK (glade_gtk_position_index_child_removed), NULL);
+		}
+
+		if (g_hash_table_lookup_extended (index, child, NULL, &position))
+			return GPOINTER_TO_INT (position);
+
+		/* A child we did not see being added, rebuild once */
+		if (rebuilt)
+			return -1;
+
+		glade_gtk_position_index_invalidate (container);
+	}
+}
+
 /* ----------------------------- GtkMenuShell ------------------------------ */
 void
 glade_gtk_menu_shell_add_child (GladeWidgetAdaptor  *adaptor, 
@@ -4515,6 +4851,7 @@ glade_gtk_menu_shell_add_child (GladeWidgetAdaptor  *adaptor,
 	g_return_if_fail (GTK_IS_MENU_ITEM (child));
 
 	gtk_menu_shell_append (GTK_MENU_SHELL (object), GTK_WIDGET (child));
+	glade_gtk_position_index_append (object, child);
 }
 
 
@@ -4527,13 +4864,21 @@ glade_gtk_menu_shell_remove_child (GladeWidgetAdaptor  *adaptor,
 	g_return_if_fail (GTK_IS_MENU_ITEM (child));
 	
 	gtk_container_remove (GTK_CONTAINER (object), GTK_WIDGET (child));
+	glade_gtk_position_index_invalidate (object);
 }
 
 static gint
 glade_gtk_menu_shell_get_item_position (GObject *container, GObject *child)
 {
-	gint position = 0;
-	GList *list = GTK_MENU_SHELL (container)->children;
+	gint position;
+	GList *list;
+
+	if ((position = glade_gtk_position_index_lookup (container, child)) >= 0)
+		return position;
+
+	/* Not a child (or no GladeWidget yet), count them all */
+	position = 0;
+	list = GTK_MENU_SHELL (container)->children;
 	
 	while (list)
 	{
@@ -4604,6 +4949,8 @@ glade_gtk_menu_shell_set_child_property (GladeWidgetAdaptor  *adaptor,
 		gtk_menu_shell_insert (GTK_MENU_SHELL (container), GTK_WIDGET (child), position);
 		g_object_unref (child);
 
+		glade_gtk_position_index_invalidate (container);
+
 	}
 	else
 		/* Chain Up */
@@ -5526,9 +5873,12 @@ glade_gtk_toolbar_get_child_property (GladeWidgetAdaptor *adaptor,
 	
 	if (strcmp (property_name, "position") == 0)
 	{
-		g_value_set_int (value,
-			 gtk_toolbar_get_item_index (GTK_TOOLBAR (container), 
-						     GTK_TOOL_ITEM (child)));
+		gint position;
+
+		if ((position = glade_gtk_position_index_lookup (container, child)) < 0)
+			position = gtk_toolbar_get_item_index (GTK_TOOLBAR (container), 
+							       GTK_TOOL_ITEM (child));
+		g_value_set_int (value, position);
 	}
 	else
 	{	/* Chain Up */
@@ -5565,6 +5915,8 @@ glade_gtk_toolbar_set_child_property (GladeWidgetAdaptor *adaptor,
 		gtk_container_remove (GTK_CONTAINER (container), GTK_WIDGET (child));
 		gtk_toolbar_insert (toolbar, GTK_TOOL_ITEM (child), position);
 		g_object_unref (child);
+
+		glade_gtk_position_index_invalidate (container);
 	}
 	else
 		/* Chain Up */
@@ -5588,15 +5940,19 @@ glade_gtk_toolbar_add_child (GladeWidgetAdaptor *adaptor,
 	item = GTK_TOOL_ITEM (child);
 	
 	gtk_toolbar_insert (toolbar, item, -1);
+	glade_gtk_position_index_append (object, child);
 		
 	if (glade_util_object_is_loading (object))
 	{
 		GladeWidget *gchild = glade_widget_get_from_gobject (child);
+		gint         position;
 		
+		if ((position = glade_gtk_position_index_lookup (object, child)) < 0)
+			position = gtk_toolbar_get_item_index (toolbar, item);
+
 		/* Packing props arent around when parenting during a glade_widget_dup() */
 		if (gchild && gchild->packing_properties)
-			glade_widget_pack_property_set (gchild, "position", 
-				gtk_toolbar_get_item_index (toolbar, item));
+			glade_widget_pack_property_set (gchild, "position", position);
 	}
 }
 
@@ -5605,6 +5961,7 @@ glade_gtk_toolbar_remove_child (GladeWidgetAdaptor *adaptor,
 				GObject *object, GObject *child)
 {
 	gtk_container_remove (GTK_CONTAINER (object), GTK_WIDGET (child));
+	glade_gtk_position_index_invalidate (object);
 }
 
 static gchar *
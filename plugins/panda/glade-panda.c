@@ -54,24 +54,120 @@ glade_gtk_panda_combo_post_create (GladeWidgetAdaptor *adaptor,
 		 "entry", "pandacombo", FALSE, reason);
 }
 
+/* Column lookups on a GtkTreeView walk a GList, so every CList keeps
+ * an array of its columns and a header widget -> column map on its
+ * GladeWidget (or the clist itself while it has none). The cache is
+ * rebuilt whenever the number of columns changes.
+ */
+typedef struct
+{
+	GPtrArray  *columns;
+	GHashTable *headers;
+} PandaCListColumns;
+
+#define PANDA_CLIST_COLUMNS "glade-panda-clist-columns"
+
+static void
+panda_clist_columns_free (PandaCListColumns *pcolumns)
+{
+	g_ptr_array_free (pcolumns->columns, TRUE);
+	g_hash_table_destroy (pcolumns->headers);
+	g_free (pcolumns);
+}
+
+static GObject *
+panda_clist_columns_owner (GtkPandaCList *clist)
+{
+	GladeWidget *gclist;
+
+	if ((gclist = glade_widget_get_from_gobject (clist)) != NULL)
+		return G_OBJECT (gclist);
+	return G_OBJECT (clist);
+}
+
+static void
+panda_clist_invalidate_columns (GtkPandaCList *clist)
+{
+	g_object_set_data (panda_clist_columns_owner (clist),
+			   PANDA_CLIST_COLUMNS, NULL);
+}
+
+static PandaCListColumns *
+panda_clist_get_columns (GtkPandaCList *clist)
+{
+	PandaCListColumns *pcolumns;
+	GObject *owner = panda_clist_columns_owner (clist);
+	GList *columns, *l;
+	GtkWidget *header;
+
+	pcolumns = g_object_get_data (owner, PANDA_CLIST_COLUMNS);
+	if (pcolumns && 
+	    pcolumns->columns->len == gtk_panda_clist_get_columns(clist))
+		return pcolumns;
+
+	pcolumns = g_new0 (PandaCListColumns, 1);
+	pcolumns->columns = g_ptr_array_new ();
+	pcolumns->headers = g_hash_table_new (NULL, NULL);
+
+	columns = gtk_tree_view_get_columns(GTK_TREE_VIEW(clist));
+	for (l = columns; l; l = l->next) {
+		g_ptr_array_add (pcolumns->columns, l->data);
+		if ((header = gtk_tree_view_column_get_widget(l->data)) != NULL)
+			g_hash_table_insert (pcolumns->headers, header, l->data);
+	}
+	g_list_free (columns);
+
+	g_object_set_data_full (owner, PANDA_CLIST_COLUMNS, pcolumns,
+				(GDestroyNotify)panda_clist_columns_free);
+	return pcolumns;
+}
+
+static void
+panda_clist_set_header (PandaCListColumns *pcolumns,
+			GtkTreeViewColumn *column,
+			GtkWidget         *header)
+{
+	GtkWidget *old = gtk_tree_view_column_get_widget(column);
+
+	if (old != NULL)
+		g_hash_table_remove (pcolumns->headers, old);
+
+	gtk_tree_view_column_set_widget(column,header);
+
+	if (header != NULL)
+		g_hash_table_insert (pcolumns->headers, header, column);
+}
+
+static GtkTreeViewColumn *
+panda_clist_find_header (PandaCListColumns *pcolumns,
+			 GtkWidget         *header)
+{
+	GtkTreeViewColumn *column = g_hash_table_lookup (pcolumns->headers, header);
+
+	if (column && gtk_tree_view_column_get_widget(column) == header)
+		return column;
+	return NULL;
+}
+
 void
 glade_gtk_panda_clist_add_child (GladeWidgetAdaptor  *adaptor,
 				GObject	*parent,
 				GObject	*child)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(parent);
+	PandaCListColumns *pcolumns = panda_clist_get_columns (clist);
 	GtkTreeViewColumn *column;
 	GtkWidget *_child;
-	int i;
+	guint i;
 
-	for(i = 0; i < gtk_panda_clist_get_columns(clist); i++) {
-		column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
+	for(i = 0; i < pcolumns->columns->len; i++) {
+		column = g_ptr_array_index (pcolumns->columns, i);
 		_child = gtk_tree_view_column_get_widget(column);
 		if (_child == NULL) {
-			gtk_tree_view_column_set_widget(column,GTK_WIDGET(child));
+			panda_clist_set_header (pcolumns, column, GTK_WIDGET(child));
 			break;
 		} else if (GLADE_IS_PLACEHOLDER(_child)) {
-			gtk_tree_view_column_set_widget(column,GTK_WIDGET(child));
+			panda_clist_set_header (pcolumns, column, GTK_WIDGET(child));
 			gtk_widget_destroy(GTK_WIDGET(_child));
 			break;
 		}
@@ -88,17 +184,11 @@ glade_gtk_panda_clist_remove_child (GladeWidgetAdaptor  *adaptor,
 				GObject	*child)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(parent);
+	PandaCListColumns *pcolumns = panda_clist_get_columns (clist);
 	GtkTreeViewColumn *column;
-	GtkWidget *_child;
-	int i;
 
-	for(i = 0; i < gtk_panda_clist_get_columns(clist); i++) {
-		column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
-		_child = gtk_tree_view_column_get_widget(column);
-		if (GTK_WIDGET(child) == GTK_WIDGET(_child)) {
-			gtk_tree_view_column_set_widget(column,glade_placeholder_new());
-		}
-	}
+	if ((column = panda_clist_find_header (pcolumns, GTK_WIDGET(child))) != NULL)
+		panda_clist_set_header (pcolumns, column, glade_placeholder_new());
 }
 
 
@@ -109,18 +199,12 @@ glade_gtk_panda_clist_replace_child (GladeWidgetAdaptor *adaptor,
 			     GObject            *new_widget)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(container);
+	PandaCListColumns *pcolumns = panda_clist_get_columns (clist);
 	GtkTreeViewColumn *column;
-	GtkWidget *_child;
-	int i;
 	GladeWidget  *gchild;
 
-	for(i = 0; i < gtk_panda_clist_get_columns(clist); i++) {
-		column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
-		_child = gtk_tree_view_column_get_widget(column);
-		if (GTK_WIDGET(_child) == GTK_WIDGET(current)) {
-			gtk_tree_view_column_set_widget(column,GTK_WIDGET(new_widget));
-		}
-	}
+	if ((column = panda_clist_find_header (pcolumns, GTK_WIDGET(current))) != NULL)
+		panda_clist_set_header (pcolumns, column, GTK_WIDGET(new_widget));
 
 	if ((gchild = glade_widget_get_from_gobject (new_widget)) != NULL)
 		/* The "Remove Slot" operation only makes sence on placeholders,
@@ -135,19 +219,20 @@ glade_gtk_panda_clist_get_children (GladeWidgetAdaptor  *adaptor,
 				  GObject        *object)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(object);
+	PandaCListColumns *pcolumns = panda_clist_get_columns (clist);
 	GtkTreeViewColumn *column;
 	GtkWidget *child;
 	GList *list = NULL;
-	int i;
+	guint i;
 
-	for(i = 0; i < gtk_panda_clist_get_columns(clist); i++) {
-		column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
+	for(i = 0; i < pcolumns->columns->len; i++) {
+		column = g_ptr_array_index (pcolumns->columns, i);
 		child = gtk_tree_view_column_get_widget(column);
 		if (child != NULL) {
-			list = g_list_append(list,child);
+			list = g_list_prepend(list,child);
 		}
 	}
-	return list;
+	return g_list_reverse (list);
 }
 
 GObject *
@@ -156,12 +241,13 @@ glade_gtk_panda_clist_get_internal_child (GladeWidgetAdaptor *adaptor,
 				  const gchar        *name)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(object);
+	PandaCListColumns *pcolumns = panda_clist_get_columns (clist);
 	GtkTreeViewColumn *column;
 	GObject *child = NULL;
-	int i;
+	guint i;
 
-	for(i = 0; i < gtk_panda_clist_get_columns(clist); i++) {
-		column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
+	for(i = 0; i < pcolumns->columns->len; i++) {
+		column = g_ptr_array_index (pcolumns->columns, i);
 		child = (GObject*)gtk_tree_view_column_get_widget(column);
 		if (child != NULL) {
 			GladeWidget *gw = glade_widget_get_from_gobject (child);
@@ -181,6 +267,7 @@ glade_gtk_panda_clist_verify_property (GladeWidgetAdaptor *adaptor,
 			       const GValue       *value)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(object);
+	PandaCListColumns *pcolumns;
 	GtkTreeViewColumn *column;
 	GtkWidget *child;
 	int i, current,new;
@@ -189,8 +276,9 @@ glade_gtk_panda_clist_verify_property (GladeWidgetAdaptor *adaptor,
 		new = g_value_get_int(value);
 		current = gtk_panda_clist_get_columns(clist);
 		if (new < current) {
+			pcolumns = panda_clist_get_columns (clist);
 			for(i = new; i < current; i++) {
-				column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
+				column = g_ptr_array_index (pcolumns->columns, i);
 				child = gtk_tree_view_column_get_widget(column);
 				if (child != NULL && !GLADE_IS_PLACEHOLDER(child)) {
 					return FALSE;
@@ -208,18 +296,20 @@ glade_gtk_panda_clist_set_property (GladeWidgetAdaptor *adaptor,
 			    const GValue       *value)
 {
 	GtkPandaCList *clist = GTK_PANDA_CLIST(object);
+	PandaCListColumns *pcolumns;
 	GtkTreeViewColumn *column;
-	GtkWidget *child;
-	int i;
+	guint i;
 
 	g_object_set_property(object,id,value);
 
 	if (!strcmp (id, "columns")) {
-		for(i = 0; i < gtk_panda_clist_get_columns(clist); i++) {
-			column = gtk_tree_view_get_column(GTK_TREE_VIEW(clist), i);
-			child = gtk_tree_view_column_get_widget(column);
-			if (child == NULL) {
-				gtk_tree_view_column_set_widget(column,glade_placeholder_new());
+		/* The clist recreates its columns here */
+		panda_clist_invalidate_columns (clist);
+		pcolumns = panda_clist_get_columns (clist);
+		for(i = 0; i < pcolumns->columns->len; i++) {
+			column = g_ptr_array_index (pcolumns->columns, i);
+			if (gtk_tree_view_column_get_widget(column) == NULL) {
+				panda_clist_set_header (pcolumns, column, glade_placeholder_new());
 			}
 		}
 	}
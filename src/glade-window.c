@@ -132,6 +132,8 @@ static void recent_chooser_item_activated_cb (GtkRecentChooser *chooser,
 
 static void check_reload_project             (GladeWindow      *window,
 					      GladeProject     *project);
+static void project_load_finished_cb         (GladeProject     *project,
+					      GladeWindow      *window);
 
 static void save_windows_config              (GladeWindow      *window);
 
@@ -485,6 +487,18 @@ window_state_event_cb (GtkWidget *widget,
 	return FALSE;
 }
 
+static gboolean
+focus_in_event_cb (GtkWidget     *widget,
+		   GdkEventFocus *event,
+		   GladeWindow   *window)
+{
+	/* Catch up with changes made while we were in the background */
+	if (window->priv->active_view)
+		check_reload_project (window, glade_design_view_get_project (window->priv->active_view));
+
+	return FALSE;
+}
+
 static GtkWidget *
 create_recent_chooser_menu (GladeWindow *window, GtkRecentManager *manager)
 {
@@ -799,35 +813,58 @@ new_cb (GtkAction *action, GladeWindow *window)
 }
 
 static void
-project_notify_handler_cb (GladeProject *project, GParamSpec *spec, GladeWindow *window)
+project_file_changed_cb (GladeProject *project, GladeWindow *window)
+{
+	/* Other projects are checked when they are switched to,
+	 * and this one when the window gets the focus back.
+	 */
+	if (window->priv->active_view &&
+	    glade_design_view_get_project (window->priv->active_view) == project &&
+	    gtk_window_is_active (GTK_WINDOW (window)))
+		check_reload_project (window, project);
+}
+
+static void
+project_resource_changed_cb (GladeProject *project, const gchar *resource, GladeWindow *window)
+{
+	glade_util_flash_message (window->priv->statusbar,
+				  window->priv->statusbar_actions_context_id,
+				  _("Resource '%s' was changed by another program"), resource);
+}
+
+static void
+project_modified_notify_cb (GladeProject *project, GParamSpec *spec, GladeWindow *window)
+{
+	refresh_title (window);
+	refresh_projects_list_item (window, project);
+}
+
+static void
+project_read_only_notify_cb (GladeProject *project, GParamSpec *spec, GladeWindow *window)
 {
 	GtkAction *action;
 
-	if (strcmp (spec->name, "modified") == 0)	
-	{
-		refresh_title (window);
-		refresh_projects_list_item (window, project);
-	}
-	else if (strcmp (spec->name, "read-only") == 0)	
-	{
-		action = gtk_action_group_get_action (window->priv->project_actions, "Save");
-		gtk_action_set_sensitive (action,
-				  	  !glade_project_get_readonly (project));
-	}
-	else if (strcmp (spec->name, "has-selection") == 0)	
-	{
-		action = gtk_action_group_get_action (window->priv->project_actions, "Cut");
-		gtk_action_set_sensitive (action,
-				  	  glade_project_get_has_selection (project));
+	action = gtk_action_group_get_action (window->priv->project_actions, "Save");
+	gtk_action_set_sensitive (action,
+				  !glade_project_get_readonly (project));
+}
 
-		action = gtk_action_group_get_action (window->priv->project_actions, "Copy");
-		gtk_action_set_sensitive (action,
-				  	  glade_project_get_has_selection (project));
+static void
+project_has_selection_notify_cb (GladeProject *project, GParamSpec *spec, GladeWindow *window)
+{
+	GtkAction *action;
 
-		action = gtk_action_group_get_action (window->priv->project_actions, "Delete");
-		gtk_action_set_sensitive (action,
-				 	  glade_project_get_has_selection (project));
-	}
+	action = gtk_action_group_get_action (window->priv->project_actions, "Cut");
+	gtk_action_set_sensitive (action,
+				  glade_project_get_has_selection (project));
+
+	action = gtk_action_group_get_action (window->priv->project_actions, "Copy");
+	gtk_action_set_sensitive (action,
+				  glade_project_get_has_selection (project));
+
+	action = gtk_action_group_get_action (window->priv->project_actions, "Delete");
+	gtk_action_set_sensitive (action,
+				  glade_project_get_has_selection (project));
 }
 
 static void
@@ -1186,15 +1223,22 @@ save (GladeWindow *window, GladeProject *project, const gchar *path)
 {
 	GError   *error = NULL;
 	gchar    *display_name, *display_path = g_strdup (path);
-	time_t    mtime;
 	GtkWidget *dialog;
 	GtkWidget *button;
 	gint       response;
 
+	/* Saving now would drop the toplevels that are not read yet */
+	if (glade_project_is_reading (project))
+	{
+		glade_util_flash_message (window->priv->statusbar,
+					  window->priv->statusbar_actions_context_id,
+					  _("Project is still loading"));
+		g_free (display_path);
+		return;
+	}
+
 	/* check for external modification to the project file */
-	mtime = glade_util_get_file_mtime (glade_project_get_path (project), NULL);
-	 
-	if (mtime > glade_project_get_file_mtime (project)) {
+	if (glade_project_get_file_changed (project)) {
 	
 		dialog = gtk_message_dialog_new (GTK_WINDOW (window),
 						 GTK_DIALOG_MODAL,
@@ -1694,6 +1738,8 @@ notebook_switch_page_cb (GtkNotebook *notebook,
 	
 	/* switch to the project's inspector */
 	gtk_notebook_set_current_page (GTK_NOTEBOOK (window->priv->inspectors_notebook), page_num);	
+
+	check_reload_project (window, project);
 	
 	/* activate the corresponding item in the project menu */
 	action_name = g_strdup_printf ("Tab_%d", page_num);
@@ -1724,15 +1770,21 @@ notebook_tab_added_cb (GtkNotebook *notebook,
 	project = glade_design_view_get_project (view);
 
 	g_signal_connect (G_OBJECT (project), "notify::modified",
-			  G_CALLBACK (project_notify_handler_cb),
+			  G_CALLBACK (project_modified_notify_cb),
 			  window);	
 	g_signal_connect (G_OBJECT (project), "selection-changed",
 			  G_CALLBACK (project_selection_changed_cb), window);
 	g_signal_connect (G_OBJECT (project), "notify::has-selection",
-			  G_CALLBACK (project_notify_handler_cb),
+			  G_CALLBACK (project_has_selection_notify_cb),
 			  window);
 	g_signal_connect (G_OBJECT (project), "notify::read-only",
-			  G_CALLBACK (project_notify_handler_cb),
+			  G_CALLBACK (project_read_only_notify_cb),
+			  window);
+	g_signal_connect (G_OBJECT (project), "file-changed",
+			  G_CALLBACK (project_file_changed_cb),
+			  window);
+	g_signal_connect (G_OBJECT (project), "resource-changed",
+			  G_CALLBACK (project_resource_changed_cb),
 			  window);
 
 	/* create inspector */
@@ -1776,12 +1828,31 @@ notebook_tab_removed_cb (GtkNotebook *notebook,
 
 	project = glade_design_view_get_project (view);	
 
+	/* Stop reading a project closed before it finished loading */
+	if (glade_project_is_reading (project))
+	{
+		glade_project_cancel_load (project);
+		project_load_finished_cb (project, window);
+	}
+
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_modified_notify_cb),
+					      window);
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_has_selection_notify_cb),
+					      window);
 	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
-					      G_CALLBACK (project_notify_handler_cb),
+					      G_CALLBACK (project_read_only_notify_cb),
 					      window);
 	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
 					      G_CALLBACK (project_selection_changed_cb),
 					      window);
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_file_changed_cb),
+					      window);
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_resource_changed_cb),
+					      window);
 
 	/* FIXME: this function needs to be preferably called somewhere else */
 	glade_app_remove_project (project);
@@ -2586,17 +2657,58 @@ glade_window_new_project (GladeWindow *window)
 	add_project (window, project);
 }
 
+static void
+project_load_progress_cb (GladeProject *project,
+			  guint         loaded,
+			  guint         total,
+			  GladeWindow  *window)
+{
+	gchar *project_name = glade_project_get_name (project);
+	gchar *message;
+
+	gtk_statusbar_pop (GTK_STATUSBAR (window->priv->statusbar),
+			   window->priv->statusbar_actions_context_id);
+	message = g_strdup_printf (_("Loading '%s': %u of %u toplevels"),
+				   project_name, loaded, total);
+	gtk_statusbar_push (GTK_STATUSBAR (window->priv->statusbar),
+			    window->priv->statusbar_actions_context_id, message);
+
+	g_free (message);
+	g_free (project_name);
+}
+
+static void
+project_load_finished_cb (GladeProject *project,
+			  GladeWindow  *window)
+{
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_load_progress_cb),
+					      window);
+	g_signal_handlers_disconnect_by_func (G_OBJECT (project),
+					      G_CALLBACK (project_load_finished_cb),
+					      window);
+
+	gtk_statusbar_pop (GTK_STATUSBAR (window->priv->statusbar),
+			   window->priv->statusbar_actions_context_id);
+}
+
 static gboolean
 open_project (GladeWindow *window, const gchar *path)
 {
 	GladeProject *project;
 	
-	project = glade_project_load (path);
+	project = glade_project_load_progressive (path);
 	if (!project)
 	{
 		recent_remove (window, path);
 		return FALSE;
 	}
+
+	/* Toplevels are read from the main loop, report how far we are */
+	g_signal_connect (G_OBJECT (project), "load-progress",
+			  G_CALLBACK (project_load_progress_cb), window);
+	g_signal_connect (G_OBJECT (project), "parse-finished",
+			  G_CALLBACK (project_load_finished_cb), window);
 	
 	add_project (window, project);
 
@@ -2618,15 +2730,18 @@ check_reload_project (GladeWindow *window, GladeProject *project)
 	GtkWidget *dialog;
 	GtkWidget *button;
 	gint       response;
+
+	static gboolean checking = FALSE;
 	
 	/* Reopen the project if it has external modifications.
 	 * Prompt for permission to reopen.
 	 */
-	if ((glade_util_get_file_mtime (glade_project_get_path (project), NULL)
-	    <= glade_project_get_file_mtime (project)))
-	{
+	if (checking || !glade_project_get_file_changed (project) ||
+	    glade_project_get_reload_declined (project))
 		return;
-	}
+
+	/* Closing the project below switches tabs, which checks again */
+	checking = TRUE;
 
 	if (glade_project_get_modified (project))
 	{
@@ -2679,6 +2794,9 @@ check_reload_project (GladeWindow *window, GladeProject *project)
 	
 	if (response == GTK_RESPONSE_REJECT)
 	{
+		/* Only ask again once the file changes again */
+		glade_project_decline_reload (project);
+		checking = FALSE;
 		return;
 	}	
 		
@@ -2689,6 +2807,8 @@ check_reload_project (GladeWindow *window, GladeProject *project)
 	do_close (window, view);
 	ret = open_project (window, path);
 	g_free (path);
+
+	checking = FALSE;
 }
 
 /** 
@@ -3239,6 +3359,9 @@ glade_window_init (GladeWindow *window)
 	g_signal_connect (G_OBJECT (window), "key-press-event",
 			  G_CALLBACK (hijack_key_press), window);
 
+	g_signal_connect (G_OBJECT (window), "focus-in-event",
+			  G_CALLBACK (focus_in_event_cb), window);
+
        /* GladeApp signals */
 	g_signal_connect (G_OBJECT (priv->app), "update-ui",
 			  G_CALLBACK (update_ui),
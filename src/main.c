@@ -61,11 +61,26 @@ static GOptionEntry option_entries[] =
 };
 
 /* Debugging arguments */
-static gboolean verbose = FALSE;
+static gboolean
+verbose_cb (const gchar  *option_name,
+	    const gchar  *value,
+	    gpointer      data,
+	    GError      **error)
+{
+	/* A bare --verbose traces everything */
+	glade_debug_set_flags (value ? value : "all");
+	return TRUE;
+}
+
+static gboolean memory_report = FALSE;
 
 static GOptionEntry debug_option_entries[] = 
 {
-  { "verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose, N_("be verbose"), NULL },
+  { "verbose", 'v', G_OPTION_FLAG_OPTIONAL_ARG, G_OPTION_ARG_CALLBACK, verbose_cb,
+    N_("be verbose, optionally only for some of parser, load, save, command, plugin and layout"),
+    N_("CATEGORY,...") },
+  { "memory-report", 0, 0, G_OPTION_ARG_NONE, &memory_report,
+    N_("load the files, print the memory used by their widgets and exit"), NULL },
   { NULL }
 };
 
@@ -83,6 +98,7 @@ main (int argc, char *argv[])
 	GOptionContext *option_context;
 	GOptionGroup *option_group;
 	GError *error = NULL;
+	const gchar *debug;
 
 	if (!g_thread_supported ())
 		g_thread_init (NULL);
@@ -94,6 +110,9 @@ main (int argc, char *argv[])
 	textdomain (GETTEXT_PACKAGE);
 #endif
 
+	if ((debug = g_getenv ("GLADE_DEBUG")) != NULL)
+		glade_debug_set_flags (debug);
+
 	/* Set up option groups */
 	option_context = g_option_context_new (NULL);
 
@@ -162,6 +181,27 @@ main (int argc, char *argv[])
 	if (without_devhelp == FALSE)
 		glade_window_check_devhelp (window);
 
+	if (memory_report) {
+		if (files != NULL)
+		{
+			guint i;
+			for (i=0; files[i] ; ++i)
+			{
+				GladeProject *project;
+
+				if ((project = glade_project_load (files[i])) != NULL)
+				{
+					glade_project_memory_report (project);
+					g_object_unref (project);
+				}
+				else
+					g_warning (_("Unable to open '%s'.\n"), files[i]);
+			}
+			g_strfreev (files);
+		}
+		exit(0);
+	}
+
 	if (filter) {
 		if (files != NULL)
 		{
@@ -0,0 +1,299 @@
+/* -*- Mode: C; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+/* Replays pointer coordinates over synthetic widget hierarchies in a
+ * GladeDesignLayout, timing glade_design_layout_widget_at() against a
+ * recursive search like the one it replaces and checking that both
+ * find the same widgets.
+ *
+ * Nothing is realized or shown: the hierarchies are made of windowless
+ * widgets which are given their allocations directly.
+ *
+ * Coordinates are read from the files given on the command line, either
+ * "x y" lines or the "Hit test at x,y" traces written by
+ * monsia3 --verbose=layout; without files a random pointer walk is
+ * replayed.
+ */
+
+#include <config.h>
+
+#include <gladeui/glade.h>
+#include <gladeui/glade-design-layout.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LAYOUT_WIDTH  1024
+#define LAYOUT_HEIGHT 768
+#define WALK_LENGTH   20000
+
+typedef struct {
+	gint x;
+	gint y;
+} HitPoint;
+
+static gint depth   = 6;
+static gint breadth = 4;
+
+static GOptionEntry option_entries[] =
+{
+	{ "depth", 'd', 0, G_OPTION_ARG_INT, &depth,
+	  "Levels of nested boxes in the synthetic hierarchies", "N" },
+	{ "breadth", 'b', 0, G_OPTION_ARG_INT, &breadth,
+	  "Children of every box in the synthetic hierarchies", "N" },
+	{ NULL }
+};
+
+/* Alternating hboxes and vboxes, with arrows as leaves */
+static GtkWidget *
+build_tree (gint level, gboolean vertical)
+{
+	GtkWidget *box;
+	gint       i;
+
+	if (level == 0)
+		return gtk_arrow_new (GTK_ARROW_UP, GTK_SHADOW_NONE);
+
+	box = vertical ? gtk_vbox_new (FALSE, 0) : gtk_hbox_new (FALSE, 0);
+	for (i = 0; i < breadth; i++)
+		gtk_container_add (GTK_CONTAINER (box),
+				   build_tree (level - 1, !vertical));
+	return box;
+}
+
+/* Lays @widget out in @area the way a box would, without a size
+ * request (which would need a screen), and maps it.
+ */
+static void
+allocate_tree (GtkWidget *widget, GdkRectangle *area)
+{
+	GdkRectangle  child_area;
+	GList        *children, *l;
+	gint          n, i;
+
+	widget->allocation = *area;
+	GTK_WIDGET_SET_FLAGS (widget, GTK_VISIBLE | GTK_MAPPED);
+
+	if (!GTK_IS_BOX (widget))
+		return;
+
+	children = gtk_container_get_children (GTK_CONTAINER (widget));
+	n = g_list_length (children);
+
+	for (i = 0, l = children; l; l = l->next, i++)
+	{
+		child_area = *area;
+		if (GTK_IS_VBOX (widget))
+		{
+			child_area.y      = area->y + area->height * i / n;
+			child_area.height = area->height * (i + 1) / n - area->height * i / n;
+		}
+		else
+		{
+			child_area.x     = area->x + area->width * i / n;
+			child_area.width = area->width * (i + 1) / n - area->width * i / n;
+		}
+		allocate_tree (l->data, &child_area);
+	}
+	g_list_free (children);
+}
+
+typedef struct {
+	GtkWidget *layout;
+	gint       x;
+	gint       y;
+	GtkWidget *found;
+} SearchData;
+
+static void
+search_child (GtkWidget *widget, SearchData *data)
+{
+	gint x, y;
+
+	gtk_widget_translate_coordinates (data->layout, widget, data->x, data->y, &x, &y);
+
+	if (GTK_WIDGET_MAPPED (widget) &&
+	    x >= 0 && x < widget->allocation.width &&
+	    y >= 0 && y < widget->allocation.height)
+		data->found = widget;
+}
+
+/* The recursive search glade_design_layout_widget_at() is measured against */
+static GtkWidget *
+search_widget_at (GtkWidget *layout, GtkWidget *container, gint x, gint y)
+{
+	SearchData data = { layout, x, y, NULL };
+
+	gtk_container_forall (GTK_CONTAINER (container),
+			      (GtkCallback)search_child, &data);
+
+	if (data.found && GTK_IS_CONTAINER (data.found))
+		return search_widget_at (layout, data.found, x, y);
+	else if (data.found)
+		return data.found;
+
+	return container;
+}
+
+static void
+read_points (const gchar *filename, GArray *points)
+{
+	HitPoint  point;
+	gchar    *contents, **lines, *line;
+	gint      i;
+
+	if (!g_file_get_contents (filename, &contents, NULL, NULL))
+	{
+		g_printerr ("Could not read %s\n", filename);
+		exit (1);
+	}
+
+	lines = g_strsplit (contents, "\n", -1);
+	for (i = 0; lines[i]; i++)
+	{
+		if ((line = strstr (lines[i], "Hit test at ")) != NULL)
+		{
+			if (sscanf (line, "Hit test at %d,%d", &point.x, &point.y) == 2)
+				g_array_append_val (points, point);
+		}
+		else if (sscanf (lines[i], "%d %d", &point.x, &point.y) == 2)
+			g_array_append_val (points, point);
+	}
+	g_strfreev (lines);
+	g_free (contents);
+}
+
+/* A pointer wandering around like a user's would */
+static void
+walk_points (GArray *points)
+{
+	HitPoint  point = { LAYOUT_WIDTH / 2, LAYOUT_HEIGHT / 2 };
+	GRand    *rand = g_rand_new_with_seed (1);
+	gint      i;
+
+	for (i = 0; i < WALK_LENGTH; i++)
+	{
+		point.x = CLAMP (point.x + g_rand_int_range (rand, -8, 9), 0, LAYOUT_WIDTH - 1);
+		point.y = CLAMP (point.y + g_rand_int_range (rand, -8, 9), 0, LAYOUT_HEIGHT - 1);
+		g_array_append_val (points, point);
+	}
+	g_rand_free (rand);
+}
+
+static gint
+replay (GArray *points, gboolean vertical)
+{
+	GtkWidget    *layout, *tree;
+	GdkRectangle  area = { 0, 0, LAYOUT_WIDTH, LAYOUT_HEIGHT };
+	GTimer       *timer;
+	HitPoint     *point;
+	gdouble       build_time, index_time, search_time;
+	guint         i;
+	gint          mismatches = 0;
+
+	layout = glade_design_layout_new ();
+	g_object_ref_sink (layout);
+
+	tree = build_tree (depth, vertical);
+	gtk_container_add (GTK_CONTAINER (layout), tree);
+
+	layout->allocation = area;
+	GTK_WIDGET_SET_FLAGS (layout, GTK_VISIBLE | GTK_MAPPED);
+	allocate_tree (tree, &area);
+
+	timer = g_timer_new ();
+
+	/* The first lookup builds the index */
+	glade_design_layout_widget_at (GLADE_DESIGN_LAYOUT (layout), 0, 0);
+	build_time = g_timer_elapsed (timer, NULL);
+
+	g_timer_start (timer);
+	for (i = 0; i < points->len; i++)
+	{
+		point = &g_array_index (points, HitPoint, i);
+		glade_design_layout_widget_at (GLADE_DESIGN_LAYOUT (layout), point->x, point->y);
+	}
+	index_time = g_timer_elapsed (timer, NULL);
+
+	g_timer_start (timer);
+	for (i = 0; i < points->len; i++)
+	{
+		point = &g_array_index (points, HitPoint, i);
+		search_widget_at (layout, layout, point->x, point->y);
+	}
+	search_time = g_timer_elapsed (timer, NULL);
+	g_timer_destroy (timer);
+
+	for (i = 0; i < points->len; i++)
+	{
+		point = &g_array_index (points, HitPoint, i);
+		if (glade_design_layout_widget_at (GLADE_DESIGN_LAYOUT (layout),
+						   point->x, point->y) !=
+		    search_widget_at (layout, layout, point->x, point->y))
+			mismatches++;
+	}
+
+	g_print ("%s tree, depth %d, breadth %d: %u lookups, "
+		 "index built in %.3fms, index %.3fms, search %.3fms, %d mismatches\n",
+		 vertical ? "vbox" : "hbox", depth, breadth, points->len,
+		 build_time * 1000, index_time * 1000, search_time * 1000, mismatches);
+
+	gtk_widget_destroy (layout);
+	g_object_unref (layout);
+
+	return mismatches;
+}
+
+int
+main (int argc, char *argv[])
+{
+	GOptionContext *context;
+	GError         *error = NULL;
+	GArray         *points;
+	gint            i, mismatches;
+
+	g_type_init ();
+
+	context = g_option_context_new ("[RECORDING...]");
+	g_option_context_add_main_entries (context, option_entries, NULL);
+	if (!g_option_context_parse (context, &argc, &argv, &error))
+	{
+		g_printerr ("%s\n", error->message);
+		return 1;
+	}
+	g_option_context_free (context);
+
+	/* Widgets only look for a screen when they get their rc style,
+	 * which does not matter for hit testing.
+	 */
+	gtk_init_check (&argc, &argv);
+
+	points = g_array_new (FALSE, FALSE, sizeof (HitPoint));
+	for (i = 1; i < argc; i++)
+		read_points (argv[i], points);
+	if (points->len == 0)
+		walk_points (points);
+
+	mismatches  = replay (points, TRUE);
+	mismatches += replay (points, FALSE);
+
+	g_array_free (points, TRUE);
+
+	return mismatches ? 1 : 0;
+}